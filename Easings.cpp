@@ -349,6 +349,25 @@ int expt::convert_value_disp2int(double val, int denom, int prec, int min, int m
 	return std::clamp(value, min, max);
 }
 
+void expt::convert_values_disp2int(std::span<double const> vals, std::span<int> dst, int denom, int prec, int min, int max)
+{
+	// the parameters of rounding are hoisted out of the loop.
+	// the condition is the same as `convert_value_disp2int()`, including the case of `mod == 1`.
+	bool const rounds = prec < denom;
+	int const mod = rounds ? denom / prec : 1, hmod = mod >> 1;
+	double const scale = denom;
+	for (size_t i = 0; i < vals.size(); i++) {
+		int value = static_cast<int>(std::round(vals[i] * scale));
+		if (rounds) {
+			int r = value % mod;
+			if (r < 0) r += mod;
+			if (r >= hmod) r -= mod;
+			value -= r;
+		}
+		dst[i] = std::clamp(value, min, max);
+	}
+}
+
 std::pair<size_t, size_t> expt::find_filter_from_track(ExEdit::Object const& obj, size_t track_index)
 {
 	size_t filter_index = 0;
@@ -158,6 +158,7 @@ namespace reactive_dlg::Easings
 		formatted_values(formatted_values const&) = default;
 		formatted_values(formatted_values&&) = default;
 		formatted_values& operator=(formatted_values const&) = default;
+		formatted_values& operator=(formatted_values&&) = default;
 	};
 
 	/// enumerates indices of all objects in the midpoint-chain.
@@ -181,6 +182,10 @@ namespace reactive_dlg::Easings
 	/// converts a displayed value to an internal value,
 	/// rounding and clamping into min-max range.
 	int convert_value_disp2int(double val, int denom, int prec, int min, int max);
+	/// the batched version of `convert_value_disp2int()`.
+	/// @param vals the displayed values.
+	/// @param dst the destination of internal values, of the same size as `vals`.
+	void convert_values_disp2int(std::span<double const> vals, std::span<int> dst, int denom, int prec, int min, int max);
 
 	/// finds the filter index and relative track index of a given track index.
 	/// @param obj the object the given trackbar belongs to.
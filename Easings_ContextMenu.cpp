@@ -14,7 +14,11 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 #include <cmath>
 #include <span>
 #include <string>
-#include <map>
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <type_traits>
 
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
@@ -27,6 +31,9 @@ using byte = uint8_t;
 
 #include "inifile_op.hpp"
 #include "clipboard.hpp"
+#include "text_scan.hpp"
+#include "expression.hpp"
+#include "index_batch.hpp"
 
 #include "reactive_dlg.hpp"
 #include "Easings.hpp"
@@ -45,51 +52,72 @@ using namespace reactive_dlg::Easings::ContextMenu;
 
 static inline uintptr_t hook_uid() { return reinterpret_cast<uintptr_t>(&settings); }
 
-template<class ExDataT>
-static inline bool scripts_match(ExEdit::Object const& obj1, int filter_index1, ExEdit::Object const& obj2, int filter_index2)
-{
-	auto& leader1 = obj1.index_midpt_leader < 0 ? obj1 : (*exedit.ObjectArray_ptr)[obj1.index_midpt_leader],
-		& leader2 = obj2.index_midpt_leader < 0 ? obj2 : (*exedit.ObjectArray_ptr)[obj2.index_midpt_leader];
-	auto data1 = reinterpret_cast<ExDataT const*>((*exedit.exdata_table) + leader1.filter_param[filter_index1].exdata_offset + 0x0004),
-		data2 = reinterpret_cast<ExDataT const*>((*exedit.exdata_table) + leader2.filter_param[filter_index2].exdata_offset + 0x0004);
-	if (data1->name[0] != '\0')
-		return std::strcmp(data1->name, data2->name) == 0;
-	return data2->name[0] == '\0' && data1->type == data2->type;
-}
-
-/// @return `-1` if no matching filter found.
-static inline int find_matching_filter(ExEdit::Object const& obj, ExEdit::Object const& src_obj, size_t src_filter_index)
-{
-	auto& filter_id = src_obj.filter_param[src_filter_index].id;
-	size_t filter_index = src_filter_index;
-
-	// for an output filter, match with the output filter of the other object.
-	if (size_t count_filters = obj.countFilters();
-		has_flag_or(exedit.loaded_filter_table[filter_id]->flag, ExEdit::Filter::Flag::Output))
-		filter_index = count_filters - 1;
-	else if (src_filter_index >= count_filters) return -1;
-
-	// check the indentities of the two filters.
-	if (obj.filter_param[filter_index].id != filter_id) return -1;
-
-	// for filters that handle scripts, those scripts must match.
-	switch (filter_id) {
-		using anm_exdata = ExEdit::Exdata::efAnimationEffect; // shared with camera eff and custom object.
-		using scn_exdata = ExEdit::Exdata::efSceneChange;
-	case filter_id::anim_eff:
-	case filter_id::cust_obj:
-	case filter_id::cam_eff:
-		if (!scripts_match<anm_exdata>(obj, filter_index, src_obj, src_filter_index)) return -1;
-		break;
+// identifies a filter on other objects that matches the given one,
+// with the properties of the source filter looked up only once.
+class filter_matcher {
+	// the identity of a script, for filters that handle scripts.
+	struct script_key {
+		std::string_view name;
+		int type;
 
-	case filter_id::scn_chg:
-		if (!scripts_match<scn_exdata>(obj, filter_index, src_obj, src_filter_index)) return -1;
-		break;
+		constexpr bool operator==(script_key const& other) const {
+			return name == other.name && (!name.empty() || type == other.type);
+		}
+	};
+	template<class ExDataT>
+	static script_key key_of(ExEdit::Object const& obj, size_t filter_index)
+	{
+		auto& leader = obj.index_midpt_leader < 0 ? obj : (*exedit.ObjectArray_ptr)[obj.index_midpt_leader];
+		auto data = reinterpret_cast<ExDataT const*>((*exedit.exdata_table) + leader.filter_param[filter_index].exdata_offset + 0x0004);
+		return { { data->name, sigma_lib::string::bounded_length(data->name, std::size(data->name)) }, data->type };
+	}
+	static script_key key_of(ExEdit::Object const& obj, size_t filter_index, int32_t id)
+	{
+		switch (id) {
+			using anm_exdata = ExEdit::Exdata::efAnimationEffect; // shared with camera eff and custom object.
+			using scn_exdata = ExEdit::Exdata::efSceneChange;
+		case filter_id::anim_eff:
+		case filter_id::cust_obj:
+		case filter_id::cam_eff:
+			return key_of<anm_exdata>(obj, filter_index);
+
+		case filter_id::scn_chg:
+			return key_of<scn_exdata>(obj, filter_index);
+		}
+		return { {}, 0 };
 	}
 
-	// all checks passed.
-	return filter_index;
-}
+	int32_t id;
+	size_t filter_index;
+	bool is_output;
+	script_key script;
+
+public:
+	filter_matcher(ExEdit::Object const& src_obj, size_t src_filter_index)
+		: id{ src_obj.filter_param[src_filter_index].id }
+		, filter_index{ src_filter_index }
+		, is_output{ has_flag_or(exedit.loaded_filter_table[id]->flag, ExEdit::Filter::Flag::Output) }
+		, script{ key_of(src_obj, src_filter_index, id) } {}
+
+	/// @return `-1` if no matching filter found.
+	int operator()(ExEdit::Object const& obj) const
+	{
+		// for an output filter, match with the output filter of the other object.
+		size_t index = filter_index;
+		if (size_t count_filters = obj.countFilters(); is_output)
+			index = count_filters - 1;
+		else if (index >= count_filters) return -1;
+
+		// check the indentities of the two filters.
+		if (obj.filter_param[index].id != id) return -1;
+
+		// for filters that handle scripts, those scripts must match.
+		if (key_of(obj, index, id) != script) return -1;
+
+		// all checks passed.
+		return static_cast<int>(index);
+	}
+};
 
 struct target_track {
 	size_t track_index;
@@ -138,18 +166,49 @@ struct target_tracks {
 			else if (v > max) max = v;
 		}
 	} values_count, flipping_values_count;
-	std::map<size_t, target_track> targets;
+	// pairs of the leading object index and the track, sorted by the index.
+	std::vector<std::pair<size_t, target_track>> targets;
 
 	// common properties of the target trackbar.
 	int track_denom, track_prec, track_min, track_max,
 		track_prec_digits;
+	// the position of the track in the filter, and the number of tracks of the filter.
+	size_t filter_track_index = 0, filter_track_count = 0;
+
+	// the chain and its values before modification, for each element of `targets`.
+	struct chain_values {
+		std::vector<int> chain, values;
+	};
+	mutable std::vector<chain_values> snapshot_cache{};
+	// collects the current values of all targets, only once per instance.
+	std::span<chain_values const> snapshot() const
+	{
+		if (snapshot_cache.size() != targets.size()) {
+			snapshot_cache.assign(targets.size(), {});
+			for_each_target(snapshot_cache, [this](chain_values& entry, size_t k) {
+				auto const& [i, track] = targets[k];
+				entry.chain = collect_pos_chain((*exedit.ObjectArray_ptr)[i]).second;
+				entry.values = collect_int_values(entry.chain, track.track_index);
+			});
+		}
+		return snapshot_cache;
+	}
+
+	// the number of chains from which per-chain computations run in parallel.
+	constexpr static size_t parallel_threshold = 256;
+	// calls `func(elem, k)` for each element of `range`, whose size is that of `targets`.
+	// each call must only touch its own element and read-only states.
+	void for_each_target(auto& range, auto&& func) const {
+		sigma_lib::batch::for_each_indexed(range, func, parallel_threshold);
+	}
 
 	std::pair<ExEdit::Object const&, target_track const&> selected_track() const {
 		auto const* const objects = *exedit.ObjectArray_ptr;
 		auto const& obj = objects[selected_object_index];
+		size_t const leading_index = obj.index_midpt_leader < 0 ? selected_object_index : obj.index_midpt_leader;
 		return {
 			obj,
-			targets.at(obj.index_midpt_leader < 0 ? selected_object_index : obj.index_midpt_leader)
+			std::ranges::lower_bound(targets, leading_index, {}, &decltype(targets)::value_type::first)->second
 		};
 	}
 	int to_internal(double val) const {
@@ -179,26 +238,27 @@ struct target_tracks {
 		for (int i = leading_index; i != selected_object_index; i = exedit.NextObjectIdxArray[i])
 			selected_section++;
 
-		// add the first element.
-		targets.try_emplace(leading_index);
-
-		// add the other selected objects.
-		for (int i : std::span{
+		// the leaders of the selected objects, including the first one, in the order of indices.
+		std::span const selection{
 			exedit.SelectingObjectIndex,
-			static_cast<size_t>(std::max(*exedit.SelectingObjectNum_ptr, 0)) }) {
-			auto const& i_leader = objects[i].index_midpt_leader;
-			targets.try_emplace(i_leader < 0 ? i : i_leader);
-		}
-
-		// eliminate objects that doesn't have a matching trackbar.
+			static_cast<size_t>(std::max(*exedit.SelectingObjectNum_ptr, 0)) };
+		auto const leaders = sigma_lib::batch::distinct_keys(leading_index, selection,
+			static_cast<size_t>(std::max(*exedit.ObjectAllocNum, 0)), [&](size_t i) {
+				auto const& i_leader = objects[i].index_midpt_leader;
+				return i_leader < 0 ? i : static_cast<size_t>(i_leader);
+			});
+
+		// collect objects in the order of indices, which have a matching trackbar.
 		auto [filter_index, filter_track_index] = find_filter_from_track(obj, track_index);
-		for (auto e = targets.end(), i = targets.begin(); i != e; ) {
-			auto const& obj_i = objects[i->first];
-			if (int const filter_index_i = find_matching_filter(obj_i, obj, filter_index);
-				filter_index_i >= 0)
-				(i++)->second.init(obj_i, // initialize the content.
+		this->filter_track_index = filter_track_index;
+		filter_track_count = std::max(exedit.loaded_filter_table[obj.filter_param[filter_index].id]->track_n, 0);
+		filter_matcher const matcher{ obj, filter_index };
+		targets.reserve(leaders.size());
+		for (size_t i : leaders) {
+			auto const& obj_i = objects[i];
+			if (int const filter_index_i = matcher(obj_i); filter_index_i >= 0)
+				targets.emplace_back(i, target_track{}).second.init(obj_i, // initialize the content.
 					obj_i.filter_param[filter_index_i].track_begin + filter_track_index);
-			else targets.erase(i++); // eliminate the element.
 		}
 
 		// inspect min/max of number of values, as well as flipping ones.
@@ -220,19 +280,165 @@ struct target_tracks {
 	target_tracks(target_tracks&&) = default;
 };
 
+// a popup menu kept across showings of the context menu.
+// items are put in order between `begin()` and `end()` as if built from scratch,
+// but the menu is modified only where it differs from the last time,
+// and labels are formatted again only when their formats or parameters change.
+struct menu_skeleton {
+	HMENU handle = nullptr;
+
+	void create() { handle = ::CreatePopupMenu(); }
+	void destroy()
+	{
+		if (handle == nullptr) return;
+		// detach the submenus first, which are owned by other skeletons.
+		truncate(0);
+		::DestroyMenu(handle);
+		handle = nullptr;
+	}
+
+	void begin() { pos = 0; }
+	// removes the items left from the last time.
+	void end() { truncate(pos); }
+
+	void add_separator() { put(kind::separator, 0, nullptr, false, {}, [](std::wstring&) {}); }
+	void add_popup(menu_skeleton const& sub, wchar_t const* title) {
+		put(kind::popup, 0, sub.handle, false, title_key(title), [&](std::wstring& label) { label = title; });
+	}
+	/// adds an item with the title formatted by `swprintf_s()`.
+	void add_string(uint32_t id, bool grayed, wchar_t const* fmt, auto... params)
+	{
+		auto& key = key_buf; key.clear();
+		feed_key(key, fmt, params...);
+		put(kind::string, id, nullptr, grayed, key, [&](std::wstring& label) {
+			if constexpr (sizeof...(params) > 0) {
+				wchar_t buf[256];
+				label.assign(buf, static_cast<size_t>(std::max(::swprintf_s(buf, std::size(buf), fmt, params...), 0)));
+			}
+			else label = fmt;
+		});
+	}
+
+	/// appends `suffix` to the title of the item at `index`, possibly graying it.
+	/// the change lasts until the next `begin()`.
+	void annotate(size_t index, wchar_t const* suffix, bool gray)
+	{
+		auto& item = items[index];
+		sync(index, item.label + suffix, item.grayed || gray);
+	}
+	// enumerates pairs of the position and the command id of the string items.
+	void for_each_command(auto&& func) const
+	{
+		for (size_t i = 0; i < items.size(); i++) {
+			if (items[i].type == kind::string) func(i, items[i].id);
+		}
+	}
+
+private:
+	enum class kind : uint8_t { separator, string, popup };
+	struct item {
+		kind type;
+		uint32_t id;
+		HMENU sub;
+		bool grayed;		// the state as built.
+		std::string key;	// the format and the parameters that `label` was made from.
+		std::wstring label;	// the title as built.
+		std::wstring shown;	// the title in the menu, which may have been annotated.
+		bool shown_grayed;	// the state in the menu.
+	};
+	std::vector<item> items{};
+	size_t pos = 0;
+	std::string key_buf{};
+
+	static std::string title_key(wchar_t const* title) {
+		return { reinterpret_cast<char const*>(title), std::wcslen(title) * sizeof(wchar_t) };
+	}
+	static void feed_key(std::string& key, wchar_t const* fmt, auto... params)
+	{
+		auto const feed = [&](void const* p, size_t n) { key.append(static_cast<char const*>(p), n); };
+		auto const feed_str = [&](wchar_t const* str) { feed(str, (std::wcslen(str) + 1) * sizeof(wchar_t)); };
+		feed_str(fmt);
+		([&] {
+			if constexpr (std::is_convertible_v<decltype(params), wchar_t const*>) feed_str(params);
+			else feed(&params, sizeof(params));
+		}(), ...);
+	}
+
+	void put(kind type, uint32_t id, HMENU sub, bool grayed, std::string_view key, auto&& make_label)
+	{
+		size_t const index = pos++;
+		if (index < items.size()) {
+			auto& slot = items[index];
+			if (slot.type == type && slot.id == id && slot.sub == sub) {
+				// the same kind of item; regenerate the label only if its inputs changed.
+				if (slot.key != key) {
+					slot.key = key;
+					make_label(slot.label);
+				}
+				slot.grayed = grayed;
+				sync(index, slot.label, grayed);
+				return;
+			}
+
+			// the layout has changed; rebuild the rest so no submenu is attached twice.
+			truncate(index);
+		}
+
+		item added{ .type = type, .id = id, .sub = sub, .grayed = grayed, .key = std::string{ key } };
+		make_label(added.label);
+		added.shown = added.label; added.shown_grayed = grayed;
+		MENUITEMINFOW mii{
+			.cbSize = sizeof(mii),
+			.fMask = MIIM_FTYPE | MIIM_STATE | MIIM_ID,
+			.fType = static_cast<UINT>(type == kind::separator ? MFT_SEPARATOR : MFT_STRING),
+			.fState = static_cast<UINT>(grayed ? MFS_GRAYED : MFS_ENABLED),
+			.wID = id,
+		};
+		if (type != kind::separator) {
+			mii.fMask |= MIIM_STRING;
+			mii.dwTypeData = added.shown.data();
+		}
+		if (type == kind::popup) {
+			mii.fMask |= MIIM_SUBMENU;
+			mii.hSubMenu = sub;
+		}
+		::InsertMenuItemW(handle, static_cast<UINT>(index), TRUE, &mii);
+		items.insert(items.begin() + index, std::move(added));
+	}
+	// removes the items from `size` on, without destroying the submenus they may have.
+	void truncate(size_t size)
+	{
+		while (items.size() > size) {
+			::RemoveMenu(handle, static_cast<UINT>(items.size() - 1), MF_BYPOSITION);
+			items.pop_back();
+		}
+	}
+	// makes the menu show the title and the state, touching only what differs.
+	void sync(size_t index, std::wstring const& title, bool grayed)
+	{
+		auto& item = items[index];
+		MENUITEMINFOW mii{ .cbSize = sizeof(mii), .fMask = 0 };
+		if (item.shown != title) {
+			item.shown = title;
+			mii.fMask |= MIIM_STRING;
+			mii.dwTypeData = item.shown.data();
+		}
+		if (item.shown_grayed != grayed) {
+			item.shown_grayed = grayed;
+			mii.fMask |= MIIM_STATE;
+			mii.fState = grayed ? MFS_GRAYED : MFS_ENABLED;
+		}
+		if (mii.fMask != 0) ::SetMenuItemInfoW(handle, static_cast<UINT>(index), TRUE, &mii);
+	}
+};
+
 struct cmd_base {
 	target_tracks const& info;
 
 protected:
 	// appends a menu item with a formatted title.
-	static void append_menu(HMENU menu, uint32_t id, bool grayed, wchar_t const* fmt, auto... params)
-	{
-		if constexpr (sizeof...(params) > 0) {
-			wchar_t buf[256];
-			::swprintf_s(buf, std::size(buf), fmt, params...);
-			append_menu(menu, id, grayed, buf);
-		}
-		else ::AppendMenuW(menu, MF_STRING | (grayed ? MF_GRAYED : 0), id, fmt);
+	static void append_menu(menu_skeleton& menu, uint32_t id, bool grayed, wchar_t const* fmt, auto... params) {
+		menu.add_string(id, grayed, fmt, params...);
 	}
 	static void push_undo(target_tracks const& info)
 	{
@@ -243,8 +449,54 @@ protected:
 
 };
 
+// the private clipboard format carrying the internal values of a track losslessly,
+// placed along with the text.
+namespace raw_values
+{
+	struct header {
+		constexpr static uint32_t magic_value = 0x56544452, current_version = 1; // "RDTV" in little endian.
+		uint32_t magic, version;
+		int32_t denom, section;
+		uint32_t count;
+		// followed by `int32_t values[count]`.
+	};
+	static inline uint32_t format()
+	{
+		static uint32_t const id = ::RegisterClipboardFormatW(L"reactive_dlg.track_values");
+		return id;
+	}
+	static inline std::vector<std::byte> encode(std::span<int const> values, int denom, int section)
+	{
+		header const head{
+			.magic = header::magic_value, .version = header::current_version,
+			.denom = denom, .section = section,
+			.count = static_cast<uint32_t>(values.size()),
+		};
+		std::vector<std::byte> ret(sizeof(head) + sizeof(int32_t) * values.size());
+		std::memcpy(ret.data(), &head, sizeof(head));
+		std::memcpy(ret.data() + sizeof(head), values.data(), sizeof(int32_t) * values.size());
+		return ret;
+	}
+	// `values` is left empty if the data is malformed.
+	static inline header decode(std::span<std::byte const> data, std::vector<int>& values)
+	{
+		values.clear();
+		header head{};
+		if (data.size() < sizeof(head)) return head;
+		std::memcpy(&head, data.data(), sizeof(head));
+		if (head.magic != header::magic_value || head.version != header::current_version ||
+			head.denom <= 0 || head.count == 0 ||
+			// the global memory can be larger than requested.
+			(data.size() - sizeof(head)) / sizeof(int32_t) < head.count) return head;
+
+		values.resize(head.count);
+		std::memcpy(values.data(), data.data() + sizeof(head), sizeof(int32_t) * head.count);
+		return head;
+	}
+}
+
 struct copy : cmd_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		append_menu(menu, id, false, L"数値をコピー (&C)");
 		return true;
@@ -253,47 +505,220 @@ struct copy : cmd_base {
 	void execute() const
 	{
 		auto [obj, track] = info.selected_track();
-		sigma_lib::W32::clipboard::write(
-			formatted_values{ obj, track.track_index }.span()
+		auto const text = formatted_values{ obj, track.track_index }.span()
 			.to_string(info.track_prec, false, false,
 				settings.clipboard_value_sep ? *settings.clipboard_value_sep :
-				formatted_valuespan::to_string_seps::arrow_flat));
+				formatted_valuespan::to_string_seps::arrow_flat);
+
+		// the internal values are also placed for pasting without loss.
+		auto const [pos, chain] = collect_pos_chain(obj);
+		auto const values = collect_int_values(chain, track.track_index);
+		int const section = values.size() == 1 ? -1 : values.size() == 2 ? 0 : pos;
+		if (!sigma_lib::W32::clipboard::write(text, raw_values::format(),
+			raw_values::encode(values, info.track_denom, section)))
+			sigma_lib::W32::clipboard::write(text);
+	}
+};
+
+// collects internal values of all the tracks of a filter, in a single pass over the chain.
+// the result is the same as `collect_int_values()` called for each track.
+static inline std::vector<std::vector<int>> collect_int_matrix(std::vector<int> const& chain, size_t track_begin, size_t track_count)
+{
+	auto const* const objects = *exedit.ObjectArray_ptr;
+	auto const& leading = objects[chain.front()];
+
+	std::vector<std::vector<int>> rows(track_count);
+	for (size_t t = 0; t < track_count; t++) {
+		rows[t].reserve(chain.size() + 1);
+		rows[t].push_back(leading.track_value_left[track_begin + t]);
+	}
+	for (int i : chain) {
+		auto const& o = objects[i];
+		for (size_t t = 0; t < track_count; t++)
+			rows[t].push_back(o.track_value_right[track_begin + t]);
+	}
+
+	// drop values that the easing doesn't use.
+	for (size_t t = 0; t < track_count; t++) {
+		auto const mode = leading.track_mode[track_begin + t];
+		if ((mode.num & 0x0f) == 0) rows[t].resize(1); // sole value.
+		else if (easing_spec{ mode }.twopoints) rows[t].resize(2);
+	}
+	return rows;
+}
+
+// applies internal values of all the tracks of a filter, in a single pass over the chain.
+// each row must have the number of values that the easing of the track requires.
+static inline void apply_int_matrix(std::vector<int> const& chain, std::span<std::vector<int> const> rows, size_t track_begin)
+{
+	auto* const objects = *exedit.ObjectArray_ptr;
+	for (size_t pos = 0; pos < chain.size(); pos++) {
+		auto& o = objects[chain[pos]];
+		for (size_t t = 0; t < rows.size(); t++) {
+			auto const& row = rows[t];
+			size_t const l = std::min(pos, row.size() - 1), r = row.size() > pos + 1 ? pos + 1 : row.size() - 1;
+			// a sole value, two points or the common cases, as in `apply_int_values()`.
+			o.track_value_left[track_begin + t] = row[row.size() == 2 ? 0 : l];
+			o.track_value_right[track_begin + t] = row[row.size() == 2 ? 1 : r];
+		}
+	}
+}
+
+struct copy_matrix : cmd_base {
+	bool append(menu_skeleton& menu, uint32_t id)
+	{
+		if (info.filter_track_count < 2) return false;
+		append_menu(menu, id, false, L"全トラックの数値をコピー");
+		return true;
+	}
+
+	// the heading line identifying the matrix format.
+	constexpr static std::wstring_view header = L"#tracks";
+
+	void execute() const
+	{
+		auto [obj, track] = info.selected_track();
+		size_t const track_begin = track.track_index - info.filter_track_index;
+		auto const rows = collect_int_matrix(collect_pos_chain(obj).second, track_begin, info.filter_track_count);
+
+		// one row per track, values separated by tabs.
+		std::wstring text{ header };
+		wchar_t buf[std::bit_ceil(TrackInfo::max_value_len + 2)];
+		for (size_t t = 0; t < rows.size(); t++) {
+			auto const& trackinfo = exedit.trackinfo_left[track_begin + t];
+			int const digits = std::lroundf(std::log10f(static_cast<float>(trackinfo.precision())));
+			wchar_t sep = L'\n';
+			for (int value : rows[t]) {
+				text += sep; sep = L'\t';
+				text.append(buf, ::swprintf_s(buf, L"%.*f", digits, trackinfo.calc_value(value)));
+			}
+		}
+		sigma_lib::W32::clipboard::write(text);
 	}
 };
 
 struct modify_base : cmd_base {
+	// the result of a dry run of a command.
+	struct diff {
+		// pairs of the position in `targets` and the new values, only for chains to be changed.
+		std::vector<std::pair<size_t, std::vector<int>>> changes;
+		size_t values_changed;
+	};
+
+	template<class CommandT>
+	diff dry_run(this CommandT const& self) {
+		return self.dry_run_core(static_cast<modify_values_ptr>(&CommandT::modify_values));
+	}
+	/// @return `true` if any of the values has changed.
 	template<class CommandT>
-	void execute(this CommandT const& self) {
+	bool execute(this CommandT const& self) {
 		// type erasing to reduce the binary size.
-		self.execute_core(static_cast<modify_values_ptr>(&CommandT::modify_values));
+		return self.execute_core(static_cast<modify_values_ptr>(&CommandT::modify_values));
 	}
 
 private:
 	using modify_values_ptr = void(modify_base::*)(int, std::vector<int>&, target_track const&) const;
-	void execute_core(modify_values_ptr modify_values) const
+	diff dry_run_core(modify_values_ptr modify_values) const
 	{
-		push_undo(info);
-
-		auto const* const objects = *exedit.ObjectArray_ptr;
-		for (auto const& [i, track] : info.targets) {
-			auto chain = collect_pos_chain(objects[i]).second;
-			auto values = collect_int_values(chain, track.track_index);
-			(this->*modify_values)(info.selected_section, values, track);
-			apply_int_values(chain, values, track.track_index);
+		// modify values in scratch buffers, and compare them with the originals.
+		// chains are independent of each other, so this step may run in parallel.
+		auto const snapshot = info.snapshot();
+		std::vector<std::pair<size_t, std::vector<int>>> results(snapshot.size());
+		info.for_each_target(results, [&](auto& result, size_t k) {
+			auto& [cnt, values] = result;
+			auto const& prev = snapshot[k].values;
+			values = prev;
+			(this->*modify_values)(info.selected_section, values, info.targets[k].second);
+
+			cnt = values.size() != prev.size() ? values.size() :
+				std::transform_reduce(values.begin(), values.end(), prev.begin(),
+					size_t{ 0 }, std::plus{}, std::not_equal_to{});
+		});
+
+		// gather the changes in the order of `targets`.
+		diff ret{ {}, 0 };
+		for (size_t k = 0; k < results.size(); k++) {
+			auto& [cnt, values] = results[k];
+			if (cnt == 0) continue;
+			ret.values_changed += cnt;
+			ret.changes.emplace_back(k, std::move(values));
+		}
+		return ret;
+	}
+	bool execute_core(modify_values_ptr modify_values) const
+	{
+		// compute the new values of every chain beforehand.
+		auto const changes = dry_run_core(modify_values).changes;
+
+		// chains without any changes need neither undo records nor updates.
+		if (settings.undo_changed_only && changes.empty()) return false;
+
+		// record the undo buffer.
+	#ifdef _DEBUG
+		LARGE_INTEGER t0, t1, freq;
+		::QueryPerformanceCounter(&t0);
+	#endif // _DEBUG
+		if (settings.undo_changed_only) {
+			exedit.nextundo();
+			for (auto const& [k, _] : changes)
+				exedit.setundo(info.targets[k].first, 0x01); // 0x01: the entire chain.
 		}
+		else push_undo(info);
+	#ifdef _DEBUG
+		::QueryPerformanceCounter(&t1); ::QueryPerformanceFrequency(&freq);
+		wchar_t buf[128];
+		::swprintf_s(buf, L"ContextMenu undo: %zu of %zu chains recorded in %.3f ms\n",
+			settings.undo_changed_only ? changes.size() : info.count_chains(), info.count_chains(),
+			1000.0 * (t1.QuadPart - t0.QuadPart) / freq.QuadPart);
+		::OutputDebugStringW(buf);
+	#endif // _DEBUG
+
+		auto const snapshot = info.snapshot();
+		for (auto const& [k, values] : changes)
+			apply_int_values(snapshot[k].chain, values, info.targets[k].second.track_index);
+		return !changes.empty();
 	}
 };
 struct paste_base : modify_base {
 	constexpr static auto root_title = L"数値を貼り付け";
 	formatted_valuespan list;
+	// the exact internal values corresponding to `list`, or empty if unavailable.
+	std::span<int const> raw{};
+
+protected:
+	// converts the element of `list` at `idx` into the internal value, taking the exact one if possible.
+	int internal_at(int idx) const
+	{
+		if (static_cast<size_t>(idx) < raw.size())
+			return std::clamp(raw[idx], info.track_min, info.track_max);
+		return info.to_internal(list.values[idx]);
+	}
+
+	// trims `list` and `raw` together, in the same way as `formatted_valuespan`.
+	void trim_from_end(int left, int right)
+	{
+		left = std::max(left, 0);
+		list = list.trim_from_end(left, right);
+		if (!raw.empty()) raw = list.empty() ? std::span<int const>{} : raw.subspan(left, list.size());
+	}
+	void trim_from_sect(int left_trail, int right_trail)
+	{
+		if (!list.has_section()) {
+			left_trail = list.size();
+			right_trail = 0;
+		}
+		trim_from_end(list.section - left_trail, list.size() - list.section - 2 - right_trail);
+	}
+	void trim_from_sect_l(int trail) { trim_from_sect(trail, list.size()); }
+	void trim_from_sect_r(int trail) { trim_from_sect(list.size(), trail); }
 };
 struct paste_unique : paste_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.max > 1) return false;
 
-		list = list.has_section_full() ? list.trim_from_sect_l(0) : list;
-		list = list.trim_from_end(0, list.size() - 1);
+		if (list.has_section_full()) trim_from_sect_l(0);
+		trim_from_end(0, list.size() - 1);
 		list.discard_section();
 		append_menu(menu, id, false, L"%s (&V) (%s)", root_title,
 			list.to_string(info.track_prec, false, false).c_str());
@@ -303,17 +728,17 @@ struct paste_unique : paste_base {
 	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
 	{
 		// set all values uniformly.
-		values.front() = convert_value_disp2int(list.values.front(),
-			info.track_denom, info.track_prec, info.track_min, info.track_max);
+		values.front() = internal_at(0);
 	}
 };
 
 struct paste_two : paste_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
 		if (!(list.size() <= 2 || list.has_section_full())) return false;
-		list = list.has_section_full() ? list.trim_from_sect(0, 0) : list.trim_from_end(0, list.size() - 2);
+		if (list.has_section_full()) trim_from_sect(0, 0);
+		else trim_from_end(0, list.size() - 2);
 		list.discard_section();
 		append_menu(menu, id, false, L"区間の左右 (%s)",
 			list.to_string(info.track_prec, false, false).c_str());
@@ -324,8 +749,8 @@ struct paste_two : paste_base {
 	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
 	{
 		// set values on the left and the right.
-		int val_l = info.to_internal(list.values.front()),
-			val_r = info.to_internal(list.values.back());
+		int val_l = internal_at(0),
+			val_r = internal_at(list.size() - 1);
 		if (values.size() > 2) {
 			values[pos] = val_l; values[pos + 1] = val_r;
 		}
@@ -334,12 +759,12 @@ struct paste_two : paste_base {
 };
 
 struct paste_left : paste_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
 		if (!(list.size() <= 2 || list.has_section_full())) return false;
-		list = list.has_section_full() ? list.trim_from_sect_l(0) : list;
-		list = list.trim_from_end(0, list.size() - 1);
+		if (list.has_section_full()) trim_from_sect_l(0);
+		trim_from_end(0, list.size() - 1);
 		list.discard_section();
 		append_menu(menu, id, false, L"区間の左だけ (%s)",
 			list.to_string(info.track_prec, false, false).c_str());
@@ -350,19 +775,19 @@ struct paste_left : paste_base {
 	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
 	{
 		// set the value on the left track.
-		int val = info.to_internal(list.values.front());
+		int val = internal_at(0);
 		if (values.size() > 2) values[pos] = val;
 		else values.front() = val;
 	}
 };
 
 struct paste_right : paste_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
 		if (!(list.size() <= 2 || list.has_section_full())) return false;
-		list = list.has_section_full() ? list.trim_from_sect_r(0) : list;
-		list = list.trim_from_end(list.size() - 1, 0);
+		if (list.has_section_full()) trim_from_sect_r(0);
+		trim_from_end(list.size() - 1, 0);
 		list.discard_section();
 		append_menu(menu, id, false, L"区間の右だけ (%s)",
 			list.to_string(info.track_prec, false, false).c_str());
@@ -373,7 +798,7 @@ struct paste_right : paste_base {
 	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
 	{
 		// set the value on the right track.
-		int val = info.to_internal(list.values.front());
+		int val = internal_at(0);
 		if (values.size() > 2) values[pos + 1] = val;
 		else values.back() = val;
 	}
@@ -381,14 +806,14 @@ struct paste_right : paste_base {
 
 struct paste_left_all : paste_base {
 	constexpr static auto menu_title = L"区間基準で左半分";
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
 		if (!list.has_section_full()) return false;
 		if (info.values_count.min >= 3 && info.selected_section > 0 &&
 			list.section > 0) {
 			// (...%s→%s→[ %s ])
-			if (list.has_section_full()) list = list.trim_from_sect_r(-1);
+			if (list.has_section_full()) trim_from_sect_r(-1);
 			append_menu(menu, id, false, L"%s (%s)", menu_title,
 				list.trim_from_end(list.size() - 3, 0)
 				.to_string(info.track_prec, true, false).c_str());
@@ -402,20 +827,20 @@ struct paste_left_all : paste_base {
 	{
 		// set values on the left half.
 		for (int p = std::max(pos - list.section, 0); p <= pos; p++)
-			values[p] = info.to_internal(list.values[p - pos + list.section]);
+			values[p] = internal_at(p - pos + list.section);
 	}
 };
 
 struct paste_right_all : paste_base {
 	constexpr static auto menu_title = L"区間基準で右半分";
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
 		if (!list.has_section_full()) return false;
 		if (info.values_count.min >= 3 && info.selected_section < info.values_count.min - 2 &&
 			list.section + 2 < list.size()) {
 			// ([ %s ]→%s→%s...)
-			if (list.has_section_full()) list = list.trim_from_sect_l(-1);
+			if (list.has_section_full()) trim_from_sect_l(-1);
 			append_menu(menu, id, false, L"%s (%s)", menu_title,
 				list.trim_from_end(0, list.size() - 3)
 				.to_string(info.track_prec, false, true).c_str());
@@ -430,13 +855,13 @@ struct paste_right_all : paste_base {
 		// set values on the right half.
 		for (int p = pos + 1, N = std::min<int>(pos + list.size() - list.section, values.size());
 			p < N; p++)
-			values[p] = info.to_internal(list.values[p - pos + list.section]);
+			values[p] = internal_at(p - pos + list.section);
 	}
 };
 
 struct paste_all : paste_base {
 	constexpr static auto menu_title = L"この区間基準";
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (!info.values_count.uniform()) return false;
 		if (!list.has_section_full()) return false;
@@ -456,18 +881,18 @@ struct paste_all : paste_base {
 		for (int p = std::max(pos - list.section, 0),
 			N = std::min<int>(pos + list.size() - list.section, values.size());
 			p < N; p++)
-			values[p] = info.to_internal(list.values[p - pos + list.section]);
+			values[p] = internal_at(p - pos + list.section);
 	}
 };
 
 struct paste_all_headed : paste_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.max == 1) return false;
 
 		// (%s→%s→%s...)
 		if (info.values_count.uniformly(2))
-			list = list.trim_from_end(0, list.size() - 2);
+			trim_from_end(0, list.size() - 2);
 		list.discard_section();
 		append_menu(menu, id, false, L"%s (%s)", list.size() == 1 ? L"先頭だけ" : L"先頭から順に",
 			list.trim_from_end(0, list.size() - 3)
@@ -480,17 +905,17 @@ struct paste_all_headed : paste_base {
 	{
 		// set the values for each interval.
 		for (int p = std::min<int>(list.size(), values.size()); --p >= 0;)
-			values[p] = info.to_internal(list.values[p]);
+			values[p] = internal_at(p);
 	}
 };
 struct paste_all_tailed : paste_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.max == 1) return false;
 
 		// (...%s→%s→%s)
 		if (info.values_count.uniformly(2))
-			list = list.trim_from_end(list.size() - 2, 0);
+			trim_from_end(list.size() - 2, 0);
 		list.discard_section();
 		append_menu(menu, id, false, L"%s (%s)", list.size() == 1 ? L"末尾だけ" : L"末尾から順に",
 			list.trim_from_end(list.size() - 3, 0)
@@ -502,11 +927,11 @@ struct paste_all_tailed : paste_base {
 	{
 		// set the values for each interval.
 		for (int p = values.size(), q = list.size(); --p >= 0 && --q >= 0;)
-			values[p] = info.to_internal(list.values[q]);
+			values[p] = internal_at(q);
 	}
 };
 struct paste_uniform : paste_base {
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.max == 1) return false;
 		if (list.size() != 1) return false;
@@ -520,13 +945,13 @@ struct paste_uniform : paste_base {
 	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
 	{
 		// set the values for all intervals uniformly.
-		auto val = info.to_internal(list.values.front());
+		auto val = internal_at(0);
 		for (auto& v : values) v = val;
 	}
 };
 struct paste_uniform_l : paste_base {
 	constexpr static auto menu_title = L"区間から左を一律に";
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
 		if (list.size() != 1) return false;
@@ -543,13 +968,13 @@ struct paste_uniform_l : paste_base {
 	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
 	{
 		// set the values for all intervals uniformly.
-		auto val = info.to_internal(list.values.front());
+		auto val = internal_at(0);
 		for (auto& v : std::span{ values }.subspan(0, pos + 1)) v = val;
 	}
 };
 struct paste_uniform_r : paste_base {
 	constexpr static auto menu_title = L"区間から右を一律に";
-	bool append(HMENU menu, uint32_t id)
+	bool append(menu_skeleton& menu, uint32_t id)
 	{
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
 		if (list.size() != 1) return false;
@@ -566,14 +991,14 @@ struct paste_uniform_r : paste_base {
 	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
 	{
 		// set the values for all intervals uniformly.
-		auto val = info.to_internal(list.values.front());
+		auto val = internal_at(0);
 		for (auto& v : std::span{ values }.subspan(pos + 1)) v = val;
 	}
 };
 
 struct write_l2r : modify_base {
 	double value; // left value.
-	bool append(HMENU menu, uint32_t id, double value_l, double value_r)
+	bool append(menu_skeleton& menu, uint32_t id, double value_l, double value_r)
 	{
 		value = value_l;
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
@@ -591,7 +1016,7 @@ struct write_l2r : modify_base {
 
 struct write_r2l : modify_base {
 	double value; // right value.
-	bool append(HMENU menu, uint32_t id, double value_l, double value_r)
+	bool append(menu_skeleton& menu, uint32_t id, double value_l, double value_r)
 	{
 		value = value_r;
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
@@ -609,7 +1034,7 @@ struct write_r2l : modify_base {
 
 struct swap_left_right : modify_base {
 	double value_l, value_r; // original values on the both sides.
-	bool append(HMENU menu, uint32_t id, double value_l, double value_r)
+	bool append(menu_skeleton& menu, uint32_t id, double value_l, double value_r)
 	{
 		this->value_l = value_l; this->value_r = value_r;
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
@@ -628,7 +1053,7 @@ struct swap_left_right : modify_base {
 struct write_left_flat : modify_base {
 	constexpr static auto menu_title = L"左の区間を一律に";
 	double value; // left value of the selected section.
-	bool append(HMENU menu, uint32_t id, double value_l, double value_r)
+	bool append(menu_skeleton& menu, uint32_t id, double value_l, double value_r)
 	{
 		value = value_l;
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
@@ -650,7 +1075,7 @@ struct write_left_flat : modify_base {
 struct write_right_flat : modify_base {
 	constexpr static auto menu_title = L"右の区間を一律に";
 	double value; // right value of the selected section.
-	bool append(HMENU menu, uint32_t id, double value_l, double value_r)
+	bool append(menu_skeleton& menu, uint32_t id, double value_l, double value_r)
 	{
 		value = value_r;
 		if (info.values_count.min == 1 || !info.values_count.uniform()) return false;
@@ -672,7 +1097,7 @@ struct write_right_flat : modify_base {
 struct translate : modify_base {
 	constexpr static auto root_title = L"数値を平行移動";
 	bool to_right;
-	bool append(HMENU menu, uint32_t id, bool right)
+	bool append(menu_skeleton& menu, uint32_t id, bool right)
 	{
 		if (info.values_count.max < 3) return false;
 
@@ -694,7 +1119,7 @@ struct translate : modify_base {
 struct flip_base : modify_base {
 	constexpr static auto root_title = L"数値を前後反転";
 protected:
-	bool append_core(HMENU menu, uint32_t id, wchar_t const* title,
+	bool append_core(menu_skeleton& menu, uint32_t id, wchar_t const* title,
 		bool require_left, bool require_right) const
 	{
 		if (info.flipping_values_count.max < 3) return false;
@@ -721,7 +1146,7 @@ protected:
 };
 
 struct flip_left : flip_base {
-	bool append(HMENU menu, uint32_t id) const
+	bool append(menu_skeleton& menu, uint32_t id) const
 	{
 		if (!info.values_count.uniform() ||
 			!append_core(menu, id, L"区間の左を中心", true, false)) return false;
@@ -735,7 +1160,7 @@ struct flip_left : flip_base {
 };
 
 struct flip_middle : flip_base {
-	bool append(HMENU menu, uint32_t id) const
+	bool append(menu_skeleton& menu, uint32_t id) const
 	{
 		if (!info.values_count.uniform() ||
 			!append_core(menu, id, L"区間の中央を中心", false, false)) return false;
@@ -749,7 +1174,7 @@ struct flip_middle : flip_base {
 };
 
 struct flip_right : flip_base {
-	bool append(HMENU menu, uint32_t id) const
+	bool append(menu_skeleton& menu, uint32_t id) const
 	{
 		if (!info.values_count.uniform() ||
 			!append_core(menu, id, L"区間の右を中心", false, true)) return false;
@@ -763,7 +1188,7 @@ struct flip_right : flip_base {
 };
 
 struct flip_entire : flip_base {
-	bool append(HMENU menu, uint32_t id) const
+	bool append(menu_skeleton& menu, uint32_t id) const
 	{
 		if (!append_core(menu, id, L"オブジェクトまるごと", false, false)) return false;
 		return true;
@@ -775,11 +1200,313 @@ struct flip_entire : flip_base {
 	}
 };
 
+struct paste_matrix : cmd_base {
+	std::vector<std::vector<double>> const* matrix;
+	bool append(menu_skeleton& menu, uint32_t id, std::vector<std::vector<double>> const& matrix)
+	{
+		if (matrix.empty() || info.filter_track_count < 2) return false;
+
+		this->matrix = &matrix;
+		append_menu(menu, id, false, L"全トラックに貼り付け (%zu/%zu トラック)",
+			std::min(matrix.size(), info.filter_track_count), info.filter_track_count);
+		return true;
+	}
+
+	/// @return `true` if any of the values has changed.
+	bool execute() const
+	{
+		size_t const track_count = std::min(matrix->size(), info.filter_track_count);
+		size_t const track_begin_sel = info.selected_track().second.track_index - info.filter_track_index;
+
+		// convert the values into the internal unit, track by track.
+		std::vector<std::vector<int>> ints(track_count);
+		for (size_t t = 0; t < track_count; t++) {
+			auto const& trackinfo = exedit.trackinfo_left[track_begin_sel + t];
+			auto const& row = (*matrix)[t];
+			ints[t].resize(row.size());
+			convert_values_disp2int(row, ints[t], trackinfo.denominator(), trackinfo.precision(),
+				trackinfo.val_int_min, trackinfo.val_int_max);
+		}
+
+		// compute the new values for each chain, fitting rows to the numbers of values.
+		struct change {
+			size_t k;
+			std::vector<std::vector<int>> rows;
+		};
+		std::vector<change> changes{};
+		auto const snapshot = info.snapshot();
+		for (size_t k = 0; k < snapshot.size(); k++) {
+			auto const& chain = snapshot[k].chain;
+			size_t const track_begin = info.targets[k].second.track_index - info.filter_track_index;
+			auto rows = collect_int_matrix(chain, track_begin, track_count);
+
+			bool changed = false;
+			for (size_t t = 0; t < track_count; t++) {
+				auto const& src = ints[t];
+				for (size_t j = 0; j < rows[t].size(); j++) {
+					int const val = src[std::min(j, src.size() - 1)];
+					changed |= std::exchange(rows[t][j], val) != val;
+				}
+			}
+			if (changed) changes.push_back({ k, std::move(rows) });
+		}
+		if (settings.undo_changed_only && changes.empty()) return false;
+
+		// record the undo buffer and apply.
+		exedit.nextundo();
+		if (settings.undo_changed_only) {
+			for (auto const& [k, _] : changes)
+				exedit.setundo(info.targets[k].first, 0x01); // 0x01: the entire chain.
+		}
+		else for (auto& [i, _] : info.targets) exedit.setundo(i, 0x01);
+
+		for (auto const& [k, rows] : changes)
+			apply_int_matrix(snapshot[k].chain, rows,
+				info.targets[k].second.track_index - info.filter_track_index);
+		return !changes.empty();
+	}
+};
+
+struct arith_base : modify_base {
+	constexpr static auto root_title = L"数値を一括計算";
+protected:
+	// applies `func` to the values in the displayed unit,
+	// then converts them back with rounding and clamping.
+	void modify_displayed(std::vector<int>& values, auto&& func) const
+	{
+		std::vector<double> disp(values.size());
+		double const inv_denom = 1.0 / info.track_denom;
+		for (size_t i = 0; i < values.size(); i++) disp[i] = values[i] * inv_denom;
+
+		func(std::span{ disp });
+
+		convert_values_disp2int(disp, values,
+			info.track_denom, info.track_prec, info.track_min, info.track_max);
+	}
+};
+
+struct arith_offset : arith_base {
+	double amount;
+	bool append(menu_skeleton& menu, uint32_t id, formatted_values const& clip)
+	{
+		if (clip.empty()) return false;
+
+		amount = clip.vals.front();
+		append_menu(menu, id, false, L"%+.*f を加算", info.track_prec_digits, amount);
+		return true;
+	}
+
+	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
+	{
+		modify_displayed(values, [&](std::span<double> disp) {
+			for (auto& v : disp) v += amount;
+		});
+	}
+};
+
+struct arith_scale : arith_base {
+	double factor;
+	bool append(menu_skeleton& menu, uint32_t id, formatted_values const& clip)
+	{
+		if (clip.empty()) return false;
+
+		factor = clip.vals.front();
+		append_menu(menu, id, false, L"%g 倍", factor);
+		return true;
+	}
+
+	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
+	{
+		modify_displayed(values, [&](std::span<double> disp) {
+			for (auto& v : disp) v *= factor;
+		});
+	}
+};
+
+struct arith_normalize : arith_base {
+	double lower, upper;
+	bool append(menu_skeleton& menu, uint32_t id, formatted_values const& clip)
+	{
+		if (clip.size() < 2) return false;
+
+		lower = clip.vals.front(); upper = clip.vals.back();
+		append_menu(menu, id, info.values_count.max < 2, L"%.*f ～ %.*f の範囲に正規化",
+			info.track_prec_digits, lower, info.track_prec_digits, upper);
+		return true;
+	}
+
+	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
+	{
+		if (values.size() < 2) return;
+		modify_displayed(values, [&](std::span<double> disp) {
+			// map the range of the values onto [lower, upper] linearly.
+			auto const [min, max] = std::ranges::minmax(disp);
+			if (min == max) return;
+			double const slope = (upper - lower) / (max - min), base = lower - min * slope;
+			for (auto& v : disp) v = base + v * slope;
+		});
+	}
+};
+
+struct arith_ramp : arith_base {
+	bool append(menu_skeleton& menu, uint32_t id)
+	{
+		append_menu(menu, id, info.values_count.max < 3, L"両端の間を等間隔に補間");
+		return true;
+	}
+
+	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
+	{
+		if (values.size() < 3) return;
+		modify_displayed(values, [&](std::span<double> disp) {
+			// values at midpoints are placed linearly by their positions in the chain.
+			double const first = disp.front(), step = (disp.back() - first) / (disp.size() - 1);
+			for (size_t i = 1; i + 1 < disp.size(); i++) disp[i] = first + step * i;
+		});
+	}
+};
+
+struct arith_smooth : arith_base {
+	bool append(menu_skeleton& menu, uint32_t id)
+	{
+		append_menu(menu, id, info.values_count.max < 3, L"中間点を平滑化");
+		return true;
+	}
+
+	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
+	{
+		if (values.size() < 3) return;
+		modify_displayed(values, [&](std::span<double> disp) {
+			// weighted average of (1, 2, 1), leaving both ends unchanged.
+			double prev = disp.front();
+			for (size_t i = 1; i + 1 < disp.size(); i++) {
+				double const curr = disp[i];
+				disp[i] = 0.25 * (prev + 2 * curr + disp[i + 1]);
+				prev = curr;
+			}
+		});
+	}
+};
+
+struct apply_expr : arith_base {
+	// names of the variables available in expressions, in the order of the values to `eval()`.
+	constexpr static std::wstring_view var_names[] = {
+		L"v", L"i", L"n", L"first", L"last", L"min", L"max",
+	};
+
+	sigma_lib::expression::program const* expr;
+	bool append(menu_skeleton& menu, uint32_t id, sigma_lib::expression::program const& expr, std::wstring_view src)
+	{
+		if (expr.empty()) return false;
+
+		this->expr = &expr;
+		constexpr int max_len = 32;
+		append_menu(menu, id, false, L"式を適用 (=%.*s%s)",
+			static_cast<int>(std::min<size_t>(src.size(), max_len)), src.data(),
+			src.size() > max_len ? formatted_valuespan::to_string_seps::ellipsis.data() : L"");
+		return true;
+	}
+
+	void modify_values(int pos, std::vector<int>& values, target_track const& track) const
+	{
+		modify_displayed(values, [&](std::span<double> disp) {
+			auto const [min, max] = std::ranges::minmax(disp);
+			double vars[] = {
+				0, 0, static_cast<double>(std::max<size_t>(disp.size() - 1, 1)),
+				disp.front(), disp.back(), min, max,
+			};
+			std::vector<double> stack(expr->stack_size());
+			for (size_t i = 0; i < disp.size(); i++) {
+				vars[0] = disp[i]; vars[1] = static_cast<double>(i);
+				// values that are not finite are left unchanged.
+				if (double const r = expr->eval(vars, stack.data()); std::isfinite(r))
+					disp[i] = r;
+			}
+		});
+	}
+};
+
+// the contents of the clipboard, kept until the clipboard changes.
+static constinit struct {
+	uint32_t seq = 0; // 0 is never a valid sequence number.
+	formatted_values values{};
+	// an expression given as a text beginning with `=`.
+	std::wstring expr_src{};
+	sigma_lib::expression::program expr{};
+	// values of multiple tracks, one row per track.
+	std::vector<std::vector<double>> matrix{};
+	// the internal values in the private format, corresponding to `values`.
+	std::vector<int> raw{};
+	int raw_denom = 0;
+
+	// parses the rows of numbers separated by tabs, commas or spaces, in a single scan.
+	static std::vector<std::vector<double>> parse_matrix(wchar_t const* p)
+	{
+		std::vector<std::vector<double>> rows{};
+		bool new_row = false; // the header line is skipped.
+		while (*p != L'\0') {
+			switch (*p) {
+			case L'\n': new_row = true; [[fallthrough]];
+			case L'\r': case L'\t': case L' ': case L',':
+				p++; continue;
+			}
+			if (!new_row && rows.empty()) { p++; continue; } // still in the header.
+
+			wchar_t* e;
+			double const val = std::wcstod(p, &e);
+			if (e == p || !std::isfinite(val)) return {}; // not a number.
+			if (new_row) { rows.emplace_back(); new_row = false; }
+			rows.back().push_back(val);
+			p = e;
+		}
+		return rows;
+	}
+
+	auto& get()
+	{
+		// the system increments the sequence number on every change of the clipboard.
+		uint32_t const curr = ::GetClipboardSequenceNumber();
+		if (curr == 0 || curr != seq) {
+			seq = curr;
+			values = {};
+			expr_src.clear(); expr = {}; matrix.clear(); raw.clear();
+
+			// prefer the private format, which needs neither parsing nor rounding.
+			if (std::vector<std::byte> data; sigma_lib::W32::clipboard::read(raw_values::format(), data)) {
+				auto const head = raw_values::decode(data, raw);
+				if (!raw.empty()) {
+					raw_denom = head.denom;
+					values.vals.resize(raw.size());
+					for (size_t i = 0; i < raw.size(); i++) values.vals[i] = raw[i] / static_cast<double>(raw_denom);
+					values.section = head.section;
+					return *this;
+				}
+			}
+
+			if (std::wstring str; sigma_lib::W32::clipboard::read(str) && !str.empty()) {
+				if (str.starts_with(copy_matrix::header))
+					matrix = parse_matrix(str.c_str() + copy_matrix::header.size());
+				else if (auto const head = str.find_first_not_of(L" \t\r\n");
+					head != str.npos && str[head] == L'=') {
+					// compile the expression only once.
+					expr_src = str.substr(head + 1);
+					expr_src.erase(expr_src.find_last_not_of(L" \t\r\n") + 1);
+					expr = sigma_lib::expression::program::compile(expr_src, apply_expr::var_names);
+				}
+				else values = { std::move(str) };
+			}
+		}
+		return *this;
+	}
+} clipboard_cache;
+
 namespace menu_id
 {
 	enum id : uint32_t {
 		dismissed = 0,
 		copy,
+		copy_matrix,
+		paste_matrix,
 
 		paste_unique,
 		paste_left_all,
@@ -807,56 +1534,104 @@ namespace menu_id
 		flip_middle,
 		flip_right,
 		flip_entire,
+
+		arith_offset,
+		arith_scale,
+		arith_normalize,
+		arith_ramp,
+		arith_smooth,
+		apply_expr,
 	};
 }
 
+// called when a (sub)menu of the context menu is about to be shown.
+static constinit struct {
+	void(*func)(void const*, HMENU) = nullptr;
+	void const* data = nullptr;
+
+	void operator()(HMENU menu) const { if (func != nullptr) func(data, menu); }
+	template<class F>
+	void bind(F const& f)
+	{
+		data = &f;
+		func = [](void const* d, HMENU menu) { (*static_cast<F const*>(d))(menu); };
+	}
+	void clear() { func = nullptr; data = nullptr; }
+} menu_popup;
+
+// the context menu and its submenus, kept alive while the plugin is active.
+static constinit struct {
+	menu_skeleton root, paste, translate, flip, arith;
+
+	void create()
+	{
+		for (auto* m : { &root, &paste, &translate, &flip, &arith }) m->create();
+	}
+	void destroy()
+	{
+		for (auto* m : { &root, &paste, &translate, &flip, &arith }) m->destroy();
+	}
+	menu_skeleton* find(HMENU handle)
+	{
+		for (auto* m : { &root, &paste, &translate, &flip, &arith })
+			if (m->handle == handle) return m;
+		return nullptr;
+	}
+} menus;
+
 static inline bool on_context_menu(HWND hwnd, size_t idx)
 {
-	constexpr auto add_sep = [](HMENU menu) {
-		return ::AppendMenuW(menu, MF_SEPARATOR, 0, nullptr);
-	};
-	constexpr auto add_sub = [](HMENU menu, HMENU sub, wchar_t const* name) {
-		return ::AppendMenuW(menu, MF_POPUP, reinterpret_cast<uintptr_t>(sub), name);
-	};
-	constexpr auto add_gray = [](HMENU menu, wchar_t const* name) {
-		return ::AppendMenuW(menu, MF_GRAYED, menu_id::dismissed, name);
-	};
-	constexpr auto pop_tail = [](HMENU menu) {
-		return ::RemoveMenu(menu, ::GetMenuItemCount(menu) - 1, MF_BYPOSITION);
+#ifdef _DEBUG
+	LARGE_INTEGER t0, t1, freq;
+	::QueryPerformanceCounter(&t0);
+#endif // _DEBUG
+
+	constexpr auto add_gray = [](menu_skeleton& menu, wchar_t const* name) {
+		menu.add_string(menu_id::dismissed, true, name);
 	};
 
 	target_tracks const info{ idx };
 
-	// prepare the context menu.
-	auto menu = ::CreatePopupMenu();
+	// prepare the context menu, reusing the items from the last time.
+	auto& menu = menus.root;
+	menu.begin();
 
 	// add menuitems.
 	// copying to clipboard.
 	copy copy{ info };
 	copy.append(menu, menu_id::copy);
-
-	// parse the clipboard string for pasting.
-	formatted_values values{};
-	if (std::wstring str; sigma_lib::W32::clipboard::read(str) && !str.empty())
-		values = { std::move(str) };
-
-	paste_unique		paste_unique	{ info, values };
-	paste_uniform		paste_uniform	{ info, values };
-	paste_uniform_l		paste_uniform_l	{ info, values };
-	paste_uniform_r		paste_uniform_r	{ info, values };
-	paste_all_headed	paste_all_headed{ info, values };
-	paste_all			paste_all		{ info, values };
-	paste_all_tailed	paste_all_tailed{ info, values };
-	paste_left_all		paste_left_all	{ info, values };
-	paste_left			paste_left		{ info, values };
-	paste_two			paste_two		{ info, values };
-	paste_right			paste_right		{ info, values };
-	paste_right_all		paste_right_all	{ info, values };
-
-	if (values.empty()) add_gray(menu, paste_base::root_title);
+	copy_matrix copy_matrix{ info };
+	copy_matrix.append(menu, menu_id::copy_matrix);
+
+	// the parsed clipboard string for pasting.
+	auto const& clip = clipboard_cache.get();
+	auto const& values = clip.values;
+	// the exact internal values are usable only for the same scale.
+	std::span<int const> const raw = clip.raw_denom == info.track_denom ? std::span<int const>{ clip.raw } : std::span<int const>{};
+
+	paste_unique		paste_unique	{ info, values, raw };
+	paste_uniform		paste_uniform	{ info, values, raw };
+	paste_uniform_l		paste_uniform_l	{ info, values, raw };
+	paste_uniform_r		paste_uniform_r	{ info, values, raw };
+	paste_all_headed	paste_all_headed{ info, values, raw };
+	paste_all			paste_all		{ info, values, raw };
+	paste_all_tailed	paste_all_tailed{ info, values, raw };
+	paste_left_all		paste_left_all	{ info, values, raw };
+	paste_left			paste_left		{ info, values, raw };
+	paste_two			paste_two		{ info, values, raw };
+	paste_right			paste_right		{ info, values, raw };
+	paste_right_all		paste_right_all	{ info, values, raw };
+
+	paste_matrix paste_matrix{ info };
+	if (values.empty()) {
+		// values of multiple tracks can be pasted instead.
+		if (!paste_matrix.append(menu, menu_id::paste_matrix, clip.matrix))
+			add_gray(menu, paste_base::root_title);
+	}
 	else if (!paste_unique			.append(menu, menu_id::paste_unique)) {
 		bool two_len = info.values_count.uniformly(2);
-		HMENU sub = ::CreatePopupMenu();
+		auto& sub = menus.paste;
+		sub.begin();
 		if (values.size() == 1) {
 			if (two_len) {
 				paste_left			.append(sub, menu_id::paste_left);
@@ -866,7 +1641,7 @@ static inline bool on_context_menu(HWND hwnd, size_t idx)
 			else {
 				paste_uniform		.append(sub, menu_id::paste_uniform);
 
-				add_sep(sub);
+				sub.add_separator();
 
 				paste_all_headed	.append(sub, menu_id::paste_all_headed);
 				if (info.values_count.uniform()) {
@@ -891,7 +1666,7 @@ static inline bool on_context_menu(HWND hwnd, size_t idx)
 			paste_all_tailed		.append(sub, menu_id::paste_all_tailed);
 
 			if (values.has_section() && info.values_count.uniform()) {
-				add_sep(sub);
+				sub.add_separator();
 
 				if (!two_len) paste_left_all.append(sub, menu_id::paste_left_all);
 				paste_left			.append(sub, menu_id::paste_left);
@@ -901,7 +1676,8 @@ static inline bool on_context_menu(HWND hwnd, size_t idx)
 			}
 		}
 
-		add_sub(menu, sub, paste_base::root_title);
+		sub.end();
+		menu.add_popup(sub, paste_base::root_title);
 	}
 
 	// commands for internal copying.
@@ -915,7 +1691,7 @@ static inline bool on_context_menu(HWND hwnd, size_t idx)
 		double value_l = exedit.trackinfo_left[idx].value(),
 			value_r = exedit.trackinfo_right[idx].value();
 
-		add_sep(menu);
+		menu.add_separator();
 
 		write_l2r		.append(menu, menu_id::write_l2r,			value_l, value_r);
 		write_r2l		.append(menu, menu_id::write_r2l,			value_l, value_r);
@@ -935,68 +1711,178 @@ static inline bool on_context_menu(HWND hwnd, size_t idx)
 	flip_right		flip_right	{ info };
 
 	if (info.flipping_values_count.min >= 3) {
-		add_sep(menu);
+		menu.add_separator();
 
 		// translations as a submenu.
-		HMENU sub = ::CreatePopupMenu();
-		trans_left		.append(sub, menu_id::trans_left, false);
-		trans_right		.append(sub, menu_id::trans_right, true);
+		auto& trans = menus.translate;
+		trans.begin();
+		trans_left		.append(trans, menu_id::trans_left, false);
+		trans_right		.append(trans, menu_id::trans_right, true);
+		trans.end();
 
-		add_sub(menu, sub, translate::root_title);
+		menu.add_popup(trans, translate::root_title);
 
 		// flippings as a submenu.
-		sub = ::CreatePopupMenu();
-		flip_entire		.append(sub, menu_id::flip_entire);
+		auto& flip = menus.flip;
+		flip.begin();
+		flip_entire		.append(flip, menu_id::flip_entire);
 		if (info.values_count.uniform()) {
-			add_sep(sub);
+			flip.add_separator();
+
+			flip_left	.append(flip, menu_id::flip_left);
+			flip_middle	.append(flip, menu_id::flip_middle);
+			flip_right	.append(flip, menu_id::flip_right);
+		}
+		flip.end();
+
+		menu.add_popup(flip, flip_base::root_title);
+	}
 
-			flip_left	.append(sub, menu_id::flip_left);
-			flip_middle	.append(sub, menu_id::flip_middle);
-			flip_right	.append(sub, menu_id::flip_right);
+	// commands for arithmetic operations.
+	arith_offset	arith_offset	{ info };
+	arith_scale		arith_scale		{ info };
+	arith_normalize	arith_normalize	{ info };
+	arith_ramp		arith_ramp		{ info };
+	arith_smooth	arith_smooth	{ info };
+	apply_expr		apply_expr		{ info };
+	{
+		menu.add_separator();
+
+		auto& sub = menus.arith;
+		sub.begin();
+		if (apply_expr.append(sub, menu_id::apply_expr, clip.expr, clip.expr_src))
+			sub.add_separator();
+		if (!values.empty()) {
+			arith_offset	.append(sub, menu_id::arith_offset,		values);
+			arith_scale		.append(sub, menu_id::arith_scale,		values);
+			arith_normalize	.append(sub, menu_id::arith_normalize,	values);
+
+			sub.add_separator();
 		}
+		arith_ramp			.append(sub, menu_id::arith_ramp);
+		arith_smooth		.append(sub, menu_id::arith_smooth);
+
+		sub.end();
+		menu.add_popup(sub, arith_base::root_title);
+	}
+	menu.end();
+
+	// show the numbers of chains to be changed for each command, when editing multiple objects.
+	// the dry runs are deferred until the (sub)menu containing the item is about to be shown.
+	auto const annotate = [&](auto const& cmd, menu_skeleton& popup, size_t pos) {
+		auto const [changes, values_changed] = cmd.dry_run();
+		wchar_t suffix[64];
+		::swprintf_s(suffix, L"\t%zu/%zu (%zu)",
+			changes.size(), info.count_chains(), values_changed);
+		popup.annotate(pos, suffix, changes.empty());
+	};
+	std::vector<HMENU> annotated{};
+	auto const annotate_popup = [&](HMENU handle) {
+		if (std::ranges::find(annotated, handle) != annotated.end()) return;
+		annotated.push_back(handle);
+
+		auto* const skeleton = menus.find(handle);
+		if (skeleton == nullptr) return;
+		auto& popup = *skeleton;
+		popup.for_each_command([&](size_t pos, uint32_t id) {
+			switch (id) {
+			case menu_id::paste_unique:		annotate(paste_unique,		popup, pos); break;
+			case menu_id::paste_left_all:	annotate(paste_left_all,	popup, pos); break;
+			case menu_id::paste_left:		annotate(paste_left,		popup, pos); break;
+			case menu_id::paste_two:		annotate(paste_two,			popup, pos); break;
+			case menu_id::paste_right:		annotate(paste_right,		popup, pos); break;
+			case menu_id::paste_right_all:	annotate(paste_right_all,	popup, pos); break;
+			case menu_id::paste_all:		annotate(paste_all,			popup, pos); break;
+			case menu_id::paste_all_headed:	annotate(paste_all_headed,	popup, pos); break;
+			case menu_id::paste_all_tailed:	annotate(paste_all_tailed,	popup, pos); break;
+			case menu_id::paste_uniform:	annotate(paste_uniform,		popup, pos); break;
+			case menu_id::paste_uniform_l:	annotate(paste_uniform_l,	popup, pos); break;
+			case menu_id::paste_uniform_r:	annotate(paste_uniform_r,	popup, pos); break;
+
+			case menu_id::write_l2r:		annotate(write_l2r,			popup, pos); break;
+			case menu_id::write_r2l:		annotate(write_r2l,			popup, pos); break;
+			case menu_id::swap_left_right:	annotate(swap_left_right,	popup, pos); break;
+			case menu_id::write_left_flat:	annotate(write_left_flat,	popup, pos); break;
+			case menu_id::write_right_flat:	annotate(write_right_flat,	popup, pos); break;
+
+			case menu_id::trans_left:		annotate(trans_left,		popup, pos); break;
+			case menu_id::trans_right:		annotate(trans_right,		popup, pos); break;
+
+			case menu_id::flip_left:		annotate(flip_left,			popup, pos); break;
+			case menu_id::flip_middle:		annotate(flip_middle,		popup, pos); break;
+			case menu_id::flip_right:		annotate(flip_right,		popup, pos); break;
+			case menu_id::flip_entire:		annotate(flip_entire,		popup, pos); break;
+
+			case menu_id::arith_offset:		annotate(arith_offset,		popup, pos); break;
+			case menu_id::arith_scale:		annotate(arith_scale,		popup, pos); break;
+			case menu_id::arith_normalize:	annotate(arith_normalize,	popup, pos); break;
+			case menu_id::arith_ramp:		annotate(arith_ramp,		popup, pos); break;
+			case menu_id::arith_smooth:		annotate(arith_smooth,		popup, pos); break;
+			case menu_id::apply_expr:		annotate(apply_expr,		popup, pos); break;
+			}
+		});
+	};
+	bool const annotating = settings.menu_diff_counts && info.count_chains() > 1;
+	if (annotating) menu_popup.bind(annotate_popup);
 
-		add_sub(menu, sub, flip_base::root_title);
+#ifdef _DEBUG
+	::QueryPerformanceCounter(&t1); ::QueryPerformanceFrequency(&freq);
+	{
+		wchar_t buf[64];
+		::swprintf_s(buf, L"ContextMenu build: %.3f ms\n", 1000.0 * (t1.QuadPart - t0.QuadPart) / freq.QuadPart);
+		::OutputDebugStringW(buf);
 	}
+#endif // _DEBUG
 
 	// show a context menu
 	TPMPARAMS tp{ .cbSize = sizeof(tp) }; ::GetWindowRect(hwnd, &tp.rcExclude);
 	POINT pt; ::GetCursorPos(&pt);
-	uint32_t id = ::TrackPopupMenuEx(menu,
-		TPM_LEFTALIGN | TPM_TOPALIGN | TPM_RETURNCMD | TPM_NONOTIFY | TPM_RIGHTBUTTON | TPM_VERTICAL,
+	uint32_t id = ::TrackPopupMenuEx(menu.handle,
+		TPM_LEFTALIGN | TPM_TOPALIGN | TPM_RETURNCMD | TPM_RIGHTBUTTON | TPM_VERTICAL |
+		(annotating ? 0 : TPM_NONOTIFY), // WM_INITMENUPOPUP is needed for annotations.
 		pt.x, pt.y, hwnd, &tp);
-	::DestroyMenu(menu);
+	menu_popup.clear();
 	if (id == menu_id::dismissed) return false;
 
 	// handle the selected item w.r.t. the returned id.
 	switch (id) {
 	case menu_id::copy:				copy			.execute(); return false;
-
-	case menu_id::paste_unique:		paste_unique	.execute(); return true;
-	case menu_id::paste_left_all:	paste_left_all	.execute(); return true;
-	case menu_id::paste_left:		paste_left		.execute(); return true;
-	case menu_id::paste_two:		paste_two		.execute(); return true;
-	case menu_id::paste_right:		paste_right		.execute(); return true;
-	case menu_id::paste_right_all:	paste_right_all	.execute(); return true;
-	case menu_id::paste_all:		paste_all		.execute(); return true;
-	case menu_id::paste_all_headed:	paste_all_headed.execute(); return true;
-	case menu_id::paste_all_tailed:	paste_all_tailed.execute(); return true;
-	case menu_id::paste_uniform:	paste_uniform	.execute(); return true;
-	case menu_id::paste_uniform_l:	paste_uniform_l	.execute(); return true;
-	case menu_id::paste_uniform_r:	paste_uniform_r	.execute(); return true;
-
-	case menu_id::write_l2r:		write_l2r		.execute(); return true;
-	case menu_id::write_r2l:		write_r2l		.execute(); return true;
-	case menu_id::swap_left_right:	swap_left_right	.execute(); return true;
-	case menu_id::write_left_flat:	write_left_flat	.execute(); return true;
-	case menu_id::write_right_flat:	write_right_flat.execute(); return true;
-
-	case menu_id::trans_left:		trans_left		.execute(); return true;
-	case menu_id::trans_right:		trans_right		.execute(); return true;
-
-	case menu_id::flip_left:		flip_left		.execute(); return true;
-	case menu_id::flip_middle:		flip_middle		.execute(); return true;
-	case menu_id::flip_right:		flip_right		.execute(); return true;
-	case menu_id::flip_entire:		flip_entire		.execute(); return true;
+	case menu_id::copy_matrix:		copy_matrix		.execute(); return false;
+	case menu_id::paste_matrix:		return paste_matrix		.execute();
+
+	case menu_id::paste_unique:		return paste_unique	.execute();
+	case menu_id::paste_left_all:	return paste_left_all	.execute();
+	case menu_id::paste_left:		return paste_left		.execute();
+	case menu_id::paste_two:		return paste_two		.execute();
+	case menu_id::paste_right:		return paste_right		.execute();
+	case menu_id::paste_right_all:	return paste_right_all	.execute();
+	case menu_id::paste_all:		return paste_all		.execute();
+	case menu_id::paste_all_headed:	return paste_all_headed.execute();
+	case menu_id::paste_all_tailed:	return paste_all_tailed.execute();
+	case menu_id::paste_uniform:	return paste_uniform	.execute();
+	case menu_id::paste_uniform_l:	return paste_uniform_l	.execute();
+	case menu_id::paste_uniform_r:	return paste_uniform_r	.execute();
+
+	case menu_id::write_l2r:		return write_l2r		.execute();
+	case menu_id::write_r2l:		return write_r2l		.execute();
+	case menu_id::swap_left_right:	return swap_left_right	.execute();
+	case menu_id::write_left_flat:	return write_left_flat	.execute();
+	case menu_id::write_right_flat:	return write_right_flat.execute();
+
+	case menu_id::trans_left:		return trans_left		.execute();
+	case menu_id::trans_right:		return trans_right		.execute();
+
+	case menu_id::flip_left:		return flip_left		.execute();
+	case menu_id::flip_middle:		return flip_middle		.execute();
+	case menu_id::flip_right:		return flip_right		.execute();
+	case menu_id::flip_entire:		return flip_entire		.execute();
+
+	case menu_id::arith_offset:		return arith_offset		.execute();
+	case menu_id::arith_scale:		return arith_scale		.execute();
+	case menu_id::arith_normalize:	return arith_normalize	.execute();
+	case menu_id::arith_ramp:		return arith_ramp		.execute();
+	case menu_id::arith_smooth:		return arith_smooth		.execute();
+	case menu_id::apply_expr:		return apply_expr		.execute();
 	}
 	return false;
 }
@@ -1022,6 +1908,10 @@ static inline LRESULT CALLBACK param_button_hook(HWND hwnd, UINT message, WPARAM
 		break;
 	}
 
+	case WM_INITMENUPOPUP:
+		if (HIWORD(lparam) == FALSE) menu_popup(reinterpret_cast<HMENU>(wparam));
+		break;
+
 	case WM_DESTROY:
 		::RemoveWindowSubclass(hwnd, &param_button_hook, id);
 		break;
@@ -1039,10 +1929,12 @@ namespace expt = reactive_dlg::Easings::ContextMenu;
 bool expt::setup(HWND hwnd, bool initializing)
 {
 	if (settings.context_menu && initializing) {
+		menus.create();
 		for (size_t i = 0; i < ExEdit::Object::MAX_TRACK; i++)
 			::SetWindowSubclass(exedit.hwnd_track_buttons[i], &param_button_hook, hook_uid(), { i });
 		return true;
 	}
+	if (!initializing) menus.destroy();
 	return false;
 }
 
@@ -1055,6 +1947,8 @@ void expt::Settings::load(char const* ini_file)
 #define read(func, fld, ...)	fld = read_ini_##func(fld, ini_file, section, #fld __VA_OPT__(,) __VA_ARGS__)
 
 	read(bool,	context_menu);
+	read(bool,	undo_changed_only);
+	read(bool,	menu_diff_counts);
 
 #undef read
 
@@ -27,7 +27,9 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 namespace reactive_dlg::Easings::ContextMenu
 {
 	inline constinit struct Settings {
-		bool context_menu = true;
+		bool context_menu = true,
+			undo_changed_only = true,
+			menu_diff_counts = true;
 		std::unique_ptr<std::wstring> clipboard_value_sep{};
 
 		void load(char const* ini_file);
@@ -11,10 +11,14 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 */
 
 #include <cstdint>
+#include <cstring>
+#include <array>
 #include <bit>
 #include <cmath>
 #include <tuple>
 #include <string>
+#include <vector>
+#include <memory>
 #include <set>
 
 #define NOMINMAX
@@ -22,14 +26,20 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 #include <Windows.h>
 #include <CommCtrl.h>
 #pragma comment(lib, "comctl32")
+#include <commdlg.h>
+#pragma comment(lib, "comdlg32")
 
 using byte = uint8_t;
 #include <exedit.hpp>
 
 #include "reactive_dlg.hpp"
 #include "Filters_ContextMenu.hpp"
+#include "Easings.hpp"
 #include "inifile_op.hpp"
 #include "clipboard.hpp"
+#include "line_breaks.hpp"
+#include "lua_escape.hpp"
+#include "text_scan.hpp"
 
 using namespace sigma_lib::string;
 
@@ -49,7 +59,8 @@ static constinit struct {
 	constexpr static uint32_t
 		filter_name_item = 1110, // the grayed-out menu item that shows the filter name.
 		base_id = 13010;
-	uint32_t copy_as_lua = 0;
+	uint32_t copy_as_lua = 0, copy_obj_as_lua = 0, copy_sel_as_lua = 0, copy_baked_lua = 0,
+		export_scene = 0;
 
 	// make sure the id isn't already used in the menu.
 	static void collect_claimed_ids(std::set<uint32_t>& ids, HMENU hmenu)
@@ -87,57 +98,35 @@ namespace menu_handles
 
 namespace lua_code
 {
+	// classes of bytes, where lead bytes are of the system code page.
+	static inline auto const& char_classes()
+	{
+		static auto const table = sigma_lib::lua::make_char_classes(
+			[](byte c) { return ::IsDBCSLeadByte(c) != FALSE; });
+		return table;
+	}
+
+	// the helper function to interpolate the baked values,
+	// where `frame` is relative to the beginning of the object.
+	constexpr std::string_view bake_helper =
+		"local function bake_value(name, frame)\n"
+		"\tlocal t, step = bake.tracks[name], bake.step\n"
+		"\tif bake.delta and not t.decoded then\n"
+		"\t\tfor i = 2, #t do t[i] = t[i - 1] + t[i] end\n"
+		"\t\tt.decoded = true\n"
+		"\tend\n"
+		"\tlocal i = math.max(math.floor(frame / step), 0)\n"
+		"\tlocal a, b = t[i + 1], t[i + 2]\n"
+		"\tif a == nil then return t[#t] / t.scale end\n"
+		"\tif b == nil then return a / t.scale end\n"
+		"\tlocal len = math.min(step, bake.length - i * step)\n"
+		"\treturn (a + (b - a) * (frame - i * step) / len) / t.scale\n"
+		"end\n";
+
 	// returns empty when escaping is not necessary.
 	static inline std::string escape_string(std::string_view const& str)
 	{
-		constexpr auto should_escape = [](char c) {
-			return ('\0' <= c && c <= '\x1f') || c == '\\' || c == '"';
-		};
-		constexpr auto append_escaped = [](std::string& s, char c) {
-			s.append(1, '\\');
-			switch (c) {
-			default:
-			{
-				char buf[4];
-				s.append(buf, ::sprintf_s(buf, "%03d", static_cast<byte>(c)));
-				return;
-			}
-			case '\a': c = 'a'; break;
-			case '\b': c = 'b'; break;
-			case '\f': c = 'f'; break;
-			case '\n': c = 'n'; break;
-			case '\r': c = 'r'; break;
-			case '\t': c = 't'; break;
-			case '\v': c = 'v'; break;
-			case '\\': c = '\\'; break;
-			case '\"': c = '\"'; break;
-			}
-			s.append(1, c);
-		};
-
-		if (std::none_of(str.begin(), str.end(), should_escape) &&
-			(str.empty() || ::IsDBCSLeadByte(str.back()) == FALSE)) return {};
-
-		std::string ret{}; ret.reserve(4 * str.size());
-		for (auto p = str.begin(), e = str.end(); p != e; p++) {
-			if (::IsDBCSLeadByte(*p) != FALSE) {
-				if (auto q = p + 1; q == e)
-					// illegal character here. let it escape.
-					append_escaped(ret, *p);
-				else {
-					if (should_escape(*q)) {
-						// turn the both to escape sequences.
-						append_escaped(ret, *p);
-						append_escaped(ret, *q);
-					}
-					else ret.append(&*p, 2); // no need to escape.
-					p = q;
-				}
-			}
-			else if (should_escape(*p)) append_escaped(ret, *p);
-			else ret.append(1, *p);
-		}
-		return ret;
+		return sigma_lib::lua::escape_string(str, char_classes());
 	}
 }
 
@@ -160,14 +149,7 @@ struct lua_codepiece {
 		else { *(dst++) = '"'; dst[2 * len] = '"'; } // by string, surround by double quotes.
 
 		// write binary content.
-		constexpr auto hex = [](byte b) -> char {
-			if (b < 10) return '0' + b;
-			else return ('a' - 10) + b;
-		};
-		for (auto p = data, e = data + len; p < e; p++) {
-			*(dst++) = hex((*p) >> 4);
-			*(dst++) = hex((*p) & 0x0f);
-		}
+		sigma_lib::lua::encode_hex(data, len, &*dst);
 
 		return *this;
 	}
@@ -200,19 +182,49 @@ static inline bool can_obj_effect(ExEdit::Filter::Flag flags)
 	return (flags & (flags_rejected | flags_required)) == flags_required;
 }
 
-static inline std::string compose_obj_effect(ExEdit::Object const& obj, ExEdit::Object const& leader, ExEdit::Object::FilterParam const& param)
+// estimates the length of the codepiece for the filter, approximately for reserving the buffer.
+static inline size_t estimate_obj_effect(ExEdit::Filter const& filter)
+{
+	constexpr size_t max_number_len = 16;
+	// escaping may quadruple the length, plus quotes and a comma.
+	constexpr auto string_len = [](char const* str) { return str == nullptr ? 3 : 4 * std::strlen(str) + 3; };
+
+	size_t len = std::size("obj.effect()\r\n") + string_len(filter.name);
+	for (int32_t i = 0; i < filter.track_n; i++)
+		len += string_len(filter.track_name[i]) + max_number_len;
+	for (int32_t i = 0; i < filter.check_n; i++)
+		len += string_len(filter.check_name[i]) + max_number_len;
+	if (filter.exdata_size > 0) {
+		int32_t size = 0;
+		for (auto const* use = filter.exdata_use;
+			size < filter.exdata_size && size + use->size <= filter.exdata_size; size += use->size, use++)
+			len += string_len(use->name) + std::max<size_t>(4 * use->size + 3, max_number_len);
+	}
+	return len;
+}
+
+static inline int track_denom(ExEdit::Filter const& filter, int32_t rel_idx)
+{
+	return filter.track_scale == nullptr ? 1 : std::max(filter.track_scale[rel_idx], 1);
+}
+
+// appends the codepiece of `obj.effect()` for the filter, without a line break.
+// returns `false` if the filter is not suitable, with nothing appended.
+// tracks flagged in `baked` refer to `bake_value()` instead of the constant values.
+static inline bool compose_obj_effect(lua_codepiece& ret, ExEdit::Object const& obj, ExEdit::Object const& leader, ExEdit::Object::FilterParam const& param,
+	bool const* baked = nullptr)
 {
 	auto const& filter = *exedit.loaded_filter_table[param.id];
-	if (!can_obj_effect(filter.flag)) return {};
+	if (!can_obj_effect(filter.flag)) return false;
 
-	lua_codepiece ret{ "obj.effect(" };
-	ret.put(filter.name);
+	ret.append("obj.effect(").put(filter.name);
 
 	// tracks
 	for (int32_t i = 0; i < filter.track_n; i++) {
-		ret.comma().put(filter.track_name[i])
-			.comma().put(obj.track_value_left[param.track_begin + i],
-				filter.track_scale == nullptr ? 1 : std::max(filter.track_scale[i], 1));
+		ret.comma().put(filter.track_name[i]).comma();
+		if (baked != nullptr && baked[i])
+			ret.append("bake_value(").put(filter.track_name[i]).append(", obj.frame)");
+		else ret.put(obj.track_value_left[param.track_begin + i], track_denom(filter, i));
 	}
 
 	// checks
@@ -257,13 +269,9 @@ static inline std::string compose_obj_effect(ExEdit::Object const& obj, ExEdit::
 				break;
 			case ExEdit::ExdataUse::Type::String:
 			{
-				std::string_view str{
-					reinterpret_cast<char const*>(data),
-					static_cast<size_t>(use->size)
-				};
-				if (auto const pos = str.find_first_of('\0'); pos != str.npos)
-					str = str.substr(0, pos);
-				ret.put(str);
+				auto const* const str = reinterpret_cast<char const*>(data);
+				ret.put(std::string_view{ str,
+					sigma_lib::string::bounded_length(str, static_cast<size_t>(use->size)) });
 				break;
 			}
 			default: std::unreachable();
@@ -271,7 +279,31 @@ static inline std::string compose_obj_effect(ExEdit::Object const& obj, ExEdit::
 		}
 	}
 
-	return ret.append(")");
+	ret.append(")");
+	return true;
+}
+
+// appends the codepieces for all the filters in the object, each followed by a line break.
+// returns the number of filters appended.
+static inline size_t compose_obj_effects(lua_codepiece& ret, ExEdit::Object const& obj, ExEdit::Object const& leader)
+{
+	size_t cnt = 0;
+	for (int i = 0, n = obj.countFilters(); i < n; i++) {
+		if (compose_obj_effect(ret, obj, leader, leader.filter_param[i])) {
+			ret.append("\n");
+			cnt++;
+		}
+	}
+	return cnt;
+}
+static inline size_t estimate_obj_effects(ExEdit::Object const& obj, ExEdit::Object const& leader)
+{
+	size_t len = 0;
+	for (int i = 0, n = obj.countFilters(); i < n; i++) {
+		auto const& filter = *exedit.loaded_filter_table[leader.filter_param[i].id];
+		if (can_obj_effect(filter.flag)) len += estimate_obj_effect(filter);
+	}
+	return len;
 }
 
 // identifies the object and the filter targeted for the manipulation.
@@ -292,6 +324,18 @@ static inline std::tuple<ExEdit::Object const*, ExEdit::Object const*, ExEdit::O
 	return { &obj, &leader, &leader.filter_param[filter_idx] };
 }
 
+static inline ExEdit::Object const& leader_of(ExEdit::Object const& obj)
+{
+	return obj.index_midpt_leader < 0 ? obj : (*exedit.ObjectArray_ptr)[obj.index_midpt_leader];
+}
+
+// sends the text to the clipboard, where line breaks are converted to CRLF.
+// the text is converted into UTF-16 directly in the clipboard memory.
+static inline void send_to_clipboard(std::string const& str)
+{
+	sigma_lib::W32::clipboard::write(str, encode_sys::CodePage);
+}
+
 static inline bool copy_as_lua()
 {
 	// check if the situation is valid.
@@ -299,24 +343,263 @@ static inline bool copy_as_lua()
 	if (o_ptr == nullptr) return false;
 
 	// try to compose the string.
-	auto str = compose_obj_effect(*o_ptr, *l_ptr, *f_ptr);
-	if (str.empty()) return false; // not a suitable filter for copying.
+	lua_codepiece code{};
+	code.s.reserve(estimate_obj_effect(*exedit.loaded_filter_table[f_ptr->id]));
+	if (!compose_obj_effect(code, *o_ptr, *l_ptr, *f_ptr))
+		return false; // not a suitable filter for copying.
+	code.append("\n");
+
+	// send to the clipboard.
+	send_to_clipboard(code.s);
+	return true;
+}
+
+// copies the focused filter, where the moving tracks are sampled at every `bake_step` frames
+// across the midpoint-chain and stored in tables, with a helper to interpolate them.
+static inline bool copy_baked_lua()
+{
+	// check if the situation is valid.
+	auto const [o_ptr, l_ptr, f_ptr] = find_target_filter();
+	if (o_ptr == nullptr) return false;
+	auto const& filter = *exedit.loaded_filter_table[f_ptr->id];
+	if (!can_obj_effect(filter.flag)) return false;
+	size_t const filter_index = f_ptr - l_ptr->filter_param;
+
+	// find the moving tracks.
+	std::vector<int32_t> tracks{};
+	auto const baked = std::make_unique<bool[]>(std::max(filter.track_n, 1));
+	for (int32_t i = 0; i < filter.track_n; i++) {
+		if ((l_ptr->track_mode[f_ptr->track_begin + i].num & 0x0f) == 0) continue; // 移動無し
+		tracks.push_back(i);
+		baked[i] = true;
+	}
+
+	// sample the values, evaluating all the moving tracks in a single pass over frames.
+	auto const objects = *exedit.ObjectArray_ptr;
+	auto const [_, chain] = reactive_dlg::Easings::collect_pos_chain(*o_ptr);
+	int const step = settings.bake_step,
+		frame_begin = objects[chain.front()].frame_begin,
+		length = objects[chain.back()].frame_end - frame_begin;
+	size_t const cnt_samples = tracks.empty() ? 0 : (length + step - 1) / step + 1;
+
+	std::vector<int> samples(cnt_samples * tracks.size());
+	for (size_t k = 0, sect = 0; k < cnt_samples; k++) {
+		int const frame = frame_begin + std::min<int>(k * step, length);
+		while (sect + 1 < chain.size() && frame > objects[chain[sect]].frame_end) sect++;
+
+		auto const ofi = reactive_dlg::Easings::object_filter_index(chain[sect], filter_index);
+		for (size_t t = 0; t < tracks.size(); t++)
+			exedit.calc_trackbar(ofi, frame, 0, &samples[k * tracks.size() + t],
+				reinterpret_cast<char*>(1 + tracks[t])); // represents the trackbar index.
+	}
 
-	// convert to CRLF line breaks, as specified in Win32 API docs.
-	for (size_t pos = 0; pos = str.find('\n', pos), pos != str.npos; pos++) {
-		if (pos > 0 && str[pos - 1] == '\r') continue;
-		str.insert(pos, 1, '\r'); pos++;
+	// compose the tables of the sampled values, delta-encoded if specified.
+	lua_codepiece code{};
+	code.s.reserve(estimate_obj_effect(filter) + lua_code::bake_helper.size() + 128
+		+ tracks.size() * (4 * 64 + 32 + 12 * cnt_samples));
+	code.append("local bake = { step = ").put(step).append(", length = ").put(length)
+		.append(", delta = ").append(settings.bake_delta ? "true" : "false").append(", tracks = {\n");
+	for (size_t t = 0; t < tracks.size(); t++) {
+		code.append("\t[").put(filter.track_name[tracks[t]])
+			.append("] = { scale = ").put(track_denom(filter, tracks[t]));
+		for (size_t k = 0; k < cnt_samples; k++) {
+			int const val = samples[k * tracks.size() + t];
+			code.comma().put(settings.bake_delta && k > 0 ? val - samples[(k - 1) * tracks.size() + t] : val);
+		}
+		code.append(" },\n");
 	}
-	str += "\r\n";
+	code.append("} }\n").append(lua_code::bake_helper);
+
+	compose_obj_effect(code, *o_ptr, *l_ptr, *f_ptr, baked.get());
+	code.append("\n");
 
 	// send to the clipboard.
-	sigma_lib::W32::clipboard::write(
-		sigma_lib::string::encode_sys::to_wide_str(str));
+	send_to_clipboard(code.s);
+	return true;
+}
+
+// copies all the filters of the object in the setting dialog.
+static inline bool copy_obj_as_lua()
+{
+	int const obj_idx = *exedit.SettingDialogObjectIndex;
+	if (obj_idx < 0) return false;
+	auto const& obj = (*exedit.ObjectArray_ptr)[obj_idx];
+	auto const& leader = leader_of(obj);
+
+	// compose into a buffer sized beforehand.
+	lua_codepiece code{};
+	code.s.reserve(estimate_obj_effects(obj, leader));
+	if (compose_obj_effects(code, obj, leader) == 0) return false;
+
+	send_to_clipboard(code.s);
+	return true;
+}
 
+// copies all the filters of every selected object, each headed by a comment.
+static inline bool copy_sel_as_lua()
+{
+	int const cnt_sel = *exedit.SelectingObjectNum_ptr;
+	if (cnt_sel <= 0) return false;
+	auto const objects = *exedit.ObjectArray_ptr;
+
+	constexpr size_t max_heading_len = 64;
+	size_t len = 0;
+	for (int i = 0; i < cnt_sel; i++) {
+		auto const& obj = objects[exedit.SelectingObjectIndex[i]];
+		len += max_heading_len + estimate_obj_effects(obj, leader_of(obj));
+	}
+
+	lua_codepiece code{};
+	code.s.reserve(len);
+	size_t cnt = 0;
+	for (int i = 0; i < cnt_sel; i++) {
+		auto const& obj = objects[exedit.SelectingObjectIndex[i]];
+
+		char buf[max_heading_len];
+		code.append(buf, ::sprintf_s(buf, "%s-- layer %d, frame %d-%d\n", i > 0 ? "\n" : "",
+			obj.layer_set + 1, obj.frame_begin + 1, obj.frame_end + 1));
+		cnt += compose_obj_effects(code, obj, leader_of(obj));
+	}
+	if (cnt == 0) return false;
+
+	send_to_clipboard(code.s);
 	return true;
 }
 
 
+////////////////////////////////
+// ファイルへの書き出し．
+////////////////////////////////
+// writes to a file through a fixed-size buffer, converting line breaks to CRLF.
+class chunk_writer {
+	HANDLE file;
+	std::string buf{};
+	bool failed = false;
+
+public:
+	constexpr static size_t chunk_size = 64 << 10;
+
+	chunk_writer(wchar_t const* path) : file{ ::CreateFileW(path, GENERIC_WRITE, 0, nullptr,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr) }
+	{
+		buf.reserve(2 * chunk_size);
+	}
+	~chunk_writer() { close(); }
+	chunk_writer(chunk_writer const&) = delete;
+
+	bool is_valid() const { return file != INVALID_HANDLE_VALUE && !failed; }
+
+	void write(std::string_view str)
+	{
+		size_t const pos = buf.size();
+		buf.resize_and_overwrite(pos + sigma_lib::string::crlf_length(str), [&](char* p, size_t sz) {
+			sigma_lib::string::copy_crlf(str, p + pos);
+			return sz;
+		});
+		if (buf.size() >= chunk_size) flush();
+	}
+	void flush()
+	{
+		if (buf.empty() || !is_valid()) return;
+		DWORD written = 0;
+		if (::WriteFile(file, buf.data(), static_cast<DWORD>(buf.size()), &written, nullptr) == FALSE ||
+			written != buf.size()) failed = true;
+		buf.clear();
+	}
+	// returns `true` if everything was written successfully.
+	bool close()
+	{
+		if (file == INVALID_HANDLE_VALUE) return false;
+		flush();
+		::CloseHandle(std::exchange(file, INVALID_HANDLE_VALUE));
+		return !failed;
+	}
+};
+
+// shows the progress on the title of the main window.
+class progress_title {
+	HWND const hwnd;
+	std::wstring original{};
+	uint32_t last_tick = 0;
+
+public:
+	progress_title(HWND hwnd) : hwnd{ hwnd }
+	{
+		original.resize_and_overwrite(::GetWindowTextLengthW(hwnd) + 1, [&](wchar_t* p, size_t sz) {
+			return ::GetWindowTextW(hwnd, p, static_cast<int>(sz));
+		});
+	}
+	~progress_title() { ::SetWindowTextW(hwnd, original.c_str()); }
+
+	void update(size_t done, size_t total)
+	{
+		// limit the frequency of updates.
+		if (uint32_t const tick = ::GetTickCount(); tick - last_tick >= 100) last_tick = tick;
+		else return;
+
+		wchar_t buf[64];
+		::swprintf_s(buf, L"書き出し中... %zu%%", total == 0 ? 100 : 100 * done / total);
+		::SetWindowTextW(hwnd, buf);
+	}
+};
+
+// writes all the filters of every object in the given scene.
+static inline void write_scene(chunk_writer& writer, int scene)
+{
+	// compose each object into a reused buffer, then pass it to the writer.
+	auto const objects = *exedit.ObjectArray_ptr;
+	progress_title progress{ exedit.fp->hwnd_parent };
+	lua_codepiece code{};
+	int const cnt_alloc = *exedit.ObjectAllocNum;
+	for (int i = 0; i < cnt_alloc; i++) {
+		auto const& obj = objects[i];
+		if (!has_flag_or(obj.flag, ExEdit::Object::Flag::Exist) ||
+			obj.scene_set != scene) continue;
+
+		code.s.clear();
+		char buf[64];
+		code.append(buf, ::sprintf_s(buf, "-- layer %d, frame %d-%d\n",
+			obj.layer_set + 1, obj.frame_begin + 1, obj.frame_end + 1));
+		if (compose_obj_effects(code, obj, leader_of(obj)) == 0) continue;
+		code.append("\n");
+		writer.write(code.s);
+
+		progress.update(i, cnt_alloc);
+	}
+}
+
+// exports the scene of the object in the setting dialog,
+// streaming into the file chosen by the user.
+static inline bool export_scene()
+{
+	int const obj_idx = *exedit.SettingDialogObjectIndex;
+	if (obj_idx < 0) return false;
+	auto const objects = *exedit.ObjectArray_ptr;
+	int const scene = objects[obj_idx].scene_set;
+
+	// choose the file.
+	wchar_t path[MAX_PATH] = L"";
+	OPENFILENAMEW ofn{
+		.lStructSize = sizeof(ofn),
+		.hwndOwner = *exedit.hwnd_setting_dlg,
+		.lpstrFilter = L"Lua スクリプト (*.lua)\0*.lua\0すべてのファイル (*.*)\0*.*\0",
+		.lpstrFile = path,
+		.nMaxFile = static_cast<DWORD>(std::size(path)),
+		.Flags = OFN_OVERWRITEPROMPT | OFN_PATHMUSTEXIST | OFN_NOCHANGEDIR,
+		.lpstrDefExt = L"lua",
+	};
+	if (::GetSaveFileNameW(&ofn) == FALSE) return false;
+
+	chunk_writer writer{ path };
+	if (writer.is_valid()) write_scene(writer, scene);
+	if (writer.close()) return true;
+
+	::MessageBoxW(*exedit.hwnd_setting_dlg, L"ファイルの書き出しに失敗しました．",
+		nullptr, MB_OK | MB_ICONEXCLAMATION);
+	return false;
+}
+
+
 ////////////////////////////////
 // Hook callbacks.
 ////////////////////////////////
@@ -328,27 +611,50 @@ static inline LRESULT CALLBACK setting_dlg_hook(HWND hwnd, UINT message, WPARAM
 		if (reinterpret_cast<HMENU>(wparam) != menu_handles::visual_obj || lparam != 0) break;
 
 		// prepare states of the menu items.
-		MENUITEMINFOW mii{
-			.cbSize = sizeof(mii),
-			.fMask = MIIM_STATE,
+		constexpr auto set_state = [](uint32_t id, bool enabled) {
+			if (id == 0) return; // the item doesn't exist.
+			MENUITEMINFOW mii{
+				.cbSize = sizeof(mii),
+				.fMask = MIIM_STATE,
+				.fState = static_cast<UINT>(enabled ? MFS_ENABLED : MFS_DISABLED),
+			};
+			::SetMenuItemInfoW(menu_handles::visual_obj, id, FALSE, &mii);
 		};
-		if (auto const [o_ptr, l_ptr, f_ptr] = find_target_filter();
-			o_ptr != nullptr &&
-			can_obj_effect(exedit.loaded_filter_table[f_ptr->id]->flag))
-			mii.fState = MFS_ENABLED;
-		else mii.fState = MFS_DISABLED;
-		::SetMenuItemInfoW(menu_handles::visual_obj, menu_id.copy_as_lua, FALSE, &mii);
+		auto const [o_ptr, l_ptr, f_ptr] = find_target_filter();
+		bool const can_copy = o_ptr != nullptr &&
+			can_obj_effect(exedit.loaded_filter_table[f_ptr->id]->flag);
+		set_state(menu_id.copy_as_lua, can_copy);
+		set_state(menu_id.copy_baked_lua, can_copy);
+		set_state(menu_id.copy_obj_as_lua, *exedit.SettingDialogObjectIndex >= 0);
+		set_state(menu_id.copy_sel_as_lua, *exedit.SelectingObjectNum_ptr > 0);
+		set_state(menu_id.export_scene, *exedit.SettingDialogObjectIndex >= 0);
 		break;
 	}
 	case WM_COMMAND:
 	{
-		if ((wparam >> 16) != 0) break;
+		if ((wparam >> 16) != 0 || wparam == 0) break;
 
 		// handle commands.
 		if (wparam == menu_id.copy_as_lua) {
 			copy_as_lua();
 			return 0;
 		}
+		if (wparam == menu_id.copy_obj_as_lua) {
+			copy_obj_as_lua();
+			return 0;
+		}
+		if (wparam == menu_id.copy_sel_as_lua) {
+			copy_sel_as_lua();
+			return 0;
+		}
+		if (wparam == menu_id.copy_baked_lua) {
+			copy_baked_lua();
+			return 0;
+		}
+		if (wparam == menu_id.export_scene) {
+			export_scene();
+			return 0;
+		}
 
 		break;
 	}
@@ -403,6 +709,33 @@ bool expt::setup(HWND hwnd, bool initializing)
 			mii.wID = menu_id.copy_as_lua;
 			mii.dwTypeData = const_cast<wchar_t*>(L"Luaスクリプトとしてコピー");
 			::InsertMenuItemW(menu_handles::visual_obj, ++insert_pos, TRUE, &mii);
+
+			// the commands to copy all the filters of the object(s).
+			menu_id.copy_obj_as_lua = menu_id.register_new_id(claimed_ids);
+			mii.wID = menu_id.copy_obj_as_lua;
+			mii.dwTypeData = const_cast<wchar_t*>(L"全フィルタをLuaスクリプトとしてコピー");
+			::InsertMenuItemW(menu_handles::visual_obj, ++insert_pos, TRUE, &mii);
+
+			menu_id.copy_sel_as_lua = menu_id.register_new_id(claimed_ids);
+			mii.wID = menu_id.copy_sel_as_lua;
+			mii.dwTypeData = const_cast<wchar_t*>(L"選択オブジェクトの全フィルタをLuaスクリプトとしてコピー");
+			::InsertMenuItemW(menu_handles::visual_obj, ++insert_pos, TRUE, &mii);
+		}
+
+		// the command to copy with the moving tracks baked.
+		if (settings.copy_baked_lua) {
+			menu_id.copy_baked_lua = menu_id.register_new_id(claimed_ids);
+			mii.wID = menu_id.copy_baked_lua;
+			mii.dwTypeData = const_cast<wchar_t*>(L"動きを焼き込んでLuaスクリプトとしてコピー");
+			::InsertMenuItemW(menu_handles::visual_obj, ++insert_pos, TRUE, &mii);
+		}
+
+		// the command to export the whole scene to a file.
+		if (settings.export_scene) {
+			menu_id.export_scene = menu_id.register_new_id(claimed_ids);
+			mii.wID = menu_id.export_scene;
+			mii.dwTypeData = const_cast<wchar_t*>(L"シーンの全オブジェクトをLuaスクリプトとして書き出し...");
+			::InsertMenuItemW(menu_handles::visual_obj, ++insert_pos, TRUE, &mii);
 		}
 
 		// hook the setting dialog to handle the menu commands.
@@ -421,6 +754,10 @@ void expt::Settings::load(char const* ini_file)
 #define read(func, fld, ...)	fld = read_ini_##func(fld, ini_file, section, #fld __VA_OPT__(,) __VA_ARGS__)
 
 	read(bool,	copy_as_lua);
+	read(bool,	copy_baked_lua);
+	read(int,	bake_step, 1, 1000);
+	read(bool,	bake_delta);
+	read(bool,	export_scene);
 
 #undef read
 }
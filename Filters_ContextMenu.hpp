@@ -26,11 +26,15 @@ namespace reactive_dlg::Filters::ContextMenu
 {
 	inline constinit struct Settings {
 		bool copy_as_lua = true;
+		bool copy_baked_lua = true;
+		int32_t bake_step = 1;
+		bool bake_delta = false;
+		bool export_scene = true;
 
 		void load(char const* ini_file);
 		bool is_enabled() const
 		{
-			return copy_as_lua;
+			return copy_as_lua || copy_baked_lua || export_scene;
 		}
 	} settings;
 
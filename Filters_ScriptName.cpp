@@ -11,8 +11,10 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 */
 
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
 #include <vector>
-#include <map>
+#include <deque>
 #include <string>
 
 #define NOMINMAX
@@ -43,6 +45,14 @@ NS_BEGIN()
 using namespace reactive_dlg::Filters::ScriptName;
 
 static inline uintptr_t hook_uid() { return reinterpret_cast<uintptr_t>(&settings); }
+static constinit HWND hwnd_host = nullptr;
+
+// the script name of a filter.
+struct script_name {
+	char const* name;	// nullptr if it's not a script-based filter.
+	filter_id::id id;
+	bool interned;		// `true` if `name` points into the host's name table, whose address is stable.
+};
 
 #ifndef _DEBUG
 constinit
@@ -54,10 +64,19 @@ static struct {
 	// retrieves the name of the script for the fiter at the given index of the given object.
 	// the filter is known to have the specific type of exdata.
 	template<class ExDataT>
-	char const* get(ExEdit::Object const& leader, ExEdit::Object::FilterParam const& filter_param) {
+	script_name get(ExEdit::Object const& leader, ExEdit::Object::FilterParam const& filter_param) {
 		auto exdata = find_exdata<ExDataT>(leader.exdata_offset, filter_param.exdata_offset);
-		return exdata->name[0] != '\0' ? exdata->name : find(exdata->type);
+		if (exdata->name[0] != '\0') return { exdata->name, filter_id::id{ filter_param.id }, false };
+		return { find(exdata->type), filter_id::id{ filter_param.id }, true };
+	}
+
+	// the number of names in the table.
+	size_t size() {
+		if (names.size() <= 1) collect();
+		return names.size() - 1;
 	}
+	// the name at the given index in the table.
+	char const* operator[](size_t idx) { return find(idx); }
 
 private:
 	std::vector<char const*> names{};
@@ -75,9 +94,8 @@ private:
 
 } basic_anm_names, basic_obj_names, basic_cam_names, basic_scn_names;
 
-// return the script name of the filter at the given index in the object,
-// or nullptr if it's not a script-based filter, plus the filter id.
-static inline std::pair<char const*, filter_id::id> get_script_name(ExEdit::Object const& obj, int32_t filter_index)
+// return the script name of the filter at the given index in the object.
+static inline script_name get_script_name(ExEdit::Object const& obj, int32_t filter_index)
 {
 	auto& leader = obj.index_midpt_leader < 0 ? obj
 		: (*exedit.ObjectArray_ptr)[obj.index_midpt_leader];
@@ -89,31 +107,66 @@ static inline std::pair<char const*, filter_id::id> get_script_name(ExEdit::Obje
 
 		switch (filter_param.id) {
 		case filter_id::anim_eff:
-			return { basic_anm_names.get<anm_exdata>(leader, filter_param), filter_id::anim_eff };
+			return basic_anm_names.get<anm_exdata>(leader, filter_param);
 
 		case filter_id::cust_obj:
-			return { basic_obj_names.get<anm_exdata>(leader, filter_param), filter_id::cust_obj };
+			return basic_obj_names.get<anm_exdata>(leader, filter_param);
 
 		case filter_id::cam_eff:
-			return { basic_cam_names.get<anm_exdata>(leader, filter_param), filter_id::cam_eff };
+			return basic_cam_names.get<anm_exdata>(leader, filter_param);
 
 		case filter_id::scn_chg:
-			return { basic_scn_names.get<scn_exdata>(leader, filter_param), filter_id::scn_chg };
+			return basic_scn_names.get<scn_exdata>(leader, filter_param);
 		}
 	}
-	return { nullptr, filter_id::id{ -1 } };
+	return { nullptr, filter_id::id{ -1 }, false };
 }
 
+// identifies the font and the DPI that the widths of captions are measured with.
+static constinit struct {
+	uint64_t key = 0;
+
+	// recalculates the key from the check button.
+	// widths measured with other keys are measured again when they are used.
+	void update(HWND check_button)
+	{
+		uint64_t hash = 0xcbf29ce484222325; // FNV-1a.
+		auto feed = [&](void const* data, size_t size) {
+			for (auto p = static_cast<byte const*>(data), e = p + size; p < e; p++)
+				hash = (hash ^ *p) * 0x00000100000001b3;
+		};
+		auto feed_int = [&](int32_t val) { feed(&val, sizeof(val)); };
+
+		LOGFONTW lf{};
+		::GetObjectW(reinterpret_cast<HFONT>(::SendMessageW(check_button, WM_GETFONT, 0, 0)), sizeof(lf), &lf);
+		feed_int(lf.lfHeight); feed_int(lf.lfWidth); feed_int(lf.lfWeight);
+		feed_int(lf.lfItalic); feed_int(lf.lfCharSet);
+		feed(lf.lfFaceName, std::wcslen(lf.lfFaceName) * sizeof(wchar_t));
+
+		HDC dc = ::GetDC(check_button);
+		feed_int(::GetDeviceCaps(dc, LOGPIXELSX));
+		feed_int(::GetDeviceCaps(dc, LOGPIXELSY));
+		::ReleaseDC(check_button, dc);
+
+		key = hash;
+	}
+} measure_context;
+
 // structure for cached formatted names and its rendered size.
 struct name_cache {
 	std::wstring caption = L"";
 	int width = -1;	// width for the text only.
+	uint64_t context = 0; // `measure_context.key` when `width` was measured.
 
 	constexpr bool is_valid() const { return width >= 0; }
+	bool is_current() const { return context == measure_context.key; }
 	void init(HWND check_button, std::wstring const& text)
 	{
 		caption = text;
-
+		measure(check_button);
+	}
+	void measure(HWND check_button)
+	{
 		// calculate the size for the text.
 		HDC dc = ::GetDC(check_button);
 		auto old_font = ::SelectObject(dc, reinterpret_cast<HFONT>(
@@ -121,6 +174,7 @@ struct name_cache {
 		width = calc_text_width(dc, caption);
 		::SelectObject(dc, old_font);
 		::ReleaseDC(check_button, dc);
+		context = measure_context.key;
 	}
 	constexpr int wd_button() const { return width + extra_button_wd; }
 
@@ -138,17 +192,147 @@ struct name_cache {
 	}
 };
 // stores and manages caches.
+// names in the host's table are keyed by their addresses, and others by their contents,
+// both in a single flat table with open addressing, so a hit involves no allocation.
+// names looked up by address are also registered by content on their first appearance,
+// so entries loaded from the persistent cache can be found.
 class cache_manager {
-	std::map<std::string, name_cache> cache;
+	struct entry {
+		std::string name;
+		name_cache cache;
+	};
+	struct slot {
+		char const* ptr;	// the key for names keyed by address, otherwise nullptr.
+		uint32_t hash;
+		uint32_t index;		// index to `entries` plus one, or zero for an empty slot.
+	};
+	std::deque<entry> entries{}; // deque never relocates elements, keeping references valid.
+	std::vector<slot> slots{};
+	size_t slots_used = 0;
 	slim_formatter const formatter;
+
+	constexpr static size_t initial_slots = 64; // must be a power of 2.
+
+	static uint32_t hash_ptr(char const* ptr) {
+		return static_cast<uint32_t>((static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr))
+			* 0x9e3779b97f4a7c15ull) >> 32);
+	}
+	// FNV-1a.
+	static uint32_t hash_str(std::string_view str) {
+		uint32_t hash = 0x811c9dc5;
+		for (auto c : str) hash = (hash ^ static_cast<uint8_t>(c)) * 0x01000193;
+		return hash;
+	}
+
+	// returns the index to `entries` plus one, or zero if not found.
+	uint32_t find_entry(char const* ptr, uint32_t hash, std::string_view name) const
+	{
+		size_t const mask = slots.size() - 1;
+		for (size_t i = hash & mask; slots[i].index != 0; i = (i + 1) & mask) {
+			auto const& s = slots[i];
+			if (s.hash != hash || s.ptr != ptr) continue;
+			if (ptr == nullptr && entries[s.index - 1].name != name) continue;
+			return s.index;
+		}
+		return 0;
+	}
+	uint32_t create_entry(std::string_view name, uint32_t hash, size_t idx)
+	{
+		stats.misses++;
+		modified = true;
+		auto& e = entries.emplace_back(std::string{ name });
+		e.cache.init(exedit.filter_checkboxes[idx], formatter(encode_sys::to_wide_str(name)));
+		uint32_t const index = static_cast<uint32_t>(entries.size());
+		insert({ nullptr, hash, index });
+		return index;
+	}
+
+	void insert(slot const& s)
+	{
+		if (2 * ++slots_used > slots.size()) {
+			// keep the load factor at most 1/2.
+			std::vector<slot> old(slots.size() * 2, slot{});
+			old.swap(slots);
+			for (auto const& o : old) {
+				if (o.index != 0) place(o);
+			}
+		}
+		place(s);
+	}
+	void place(slot const& s)
+	{
+		size_t const mask = slots.size() - 1;
+		size_t i = s.hash & mask;
+		while (slots[i].index != 0) i = (i + 1) & mask;
+		slots[i] = s;
+	}
+
 public:
-	cache_manager(std::wstring const& fmt) : formatter{ fmt }, cache{} {}
-	name_cache const& find_cache(char const* name, size_t idx) {
-		auto& ret = cache[name];
-		if (!ret.is_valid())
-			ret.init(exedit.filter_checkboxes[idx], formatter(encode_sys::to_wide_str(name)));
+	struct {
+		size_t hits = 0, misses = 0;
+	} stats{};
+	bool modified = false; // whether entries were added or re-measured since `preload()`.
+
+	cache_manager(std::wstring const& fmt) : slots(initial_slots, slot{}), formatter{ fmt } {}
+	name_cache const& find_cache(char const* name, bool interned, size_t idx)
+	{
+		uint32_t index;
+		if (interned) {
+			uint32_t const hash = hash_ptr(name);
+			index = find_entry(name, hash, {});
+			if (index != 0) stats.hits++;
+			else {
+				// look up by content, and bind the address to the found one.
+				std::string_view const str{ name };
+				uint32_t const hash_content = hash_str(str);
+				index = find_entry(nullptr, hash_content, str);
+				if (index != 0) stats.hits++;
+				else index = create_entry(str, hash_content, idx);
+				insert({ name, hash, index });
+			}
+		}
+		else {
+			std::string_view const str{ name };
+			uint32_t const hash = hash_str(str);
+			index = find_entry(nullptr, hash, str);
+			if (index != 0) stats.hits++;
+			else index = create_entry(str, hash, idx);
+		}
+
+		// measure again if the font or the DPI has changed since.
+		auto& cache = entries[index - 1].cache;
+		if (!cache.is_current()) {
+			cache.measure(exedit.filter_checkboxes[idx]);
+			modified = true;
+		}
+		return cache;
+	}
+
+	// adds an entry without measuring, such as one loaded from the persistent cache.
+	void preload(std::string_view name, std::wstring_view caption, int width)
+	{
+		uint32_t const hash = hash_str(name);
+		if (find_entry(nullptr, hash, name) != 0) return;
+		entries.emplace_back(std::string{ name },
+			name_cache{ std::wstring{ caption }, width, measure_context.key });
+		insert({ nullptr, hash, static_cast<uint32_t>(entries.size()) });
+	}
+	// enumerates the pairs of the name and the cache.
+	void for_each(auto&& func) const {
+		for (auto const& e : entries) func(e.name, e.cache);
+	}
+
+	// approximate number of bytes in use.
+	size_t memory_usage() const
+	{
+		size_t ret = sizeof(*this) + slots.capacity() * sizeof(slot) + entries.size() * sizeof(entry);
+		for (auto const& e : entries) {
+			ret += e.name.capacity() + 1;
+			ret += (e.cache.caption.capacity() + 1) * sizeof(wchar_t);
+		}
 		return ret;
 	}
+	size_t count() const { return entries.size(); }
 };
 static constinit std::unique_ptr<cache_manager>
 	anim_eff{},
@@ -156,10 +340,160 @@ static constinit std::unique_ptr<cache_manager>
 	cam_eff{},
 	scn_change{};
 
+// every cache in the order used as "kind" in the persistent cache.
+constexpr std::unique_ptr<cache_manager>* all_caches[] = {
+	&anim_eff,
+	&cust_std, &cust_ext, &cust_prtcl,
+	&cam_eff,
+	&scn_change,
+};
+
+
+////////////////////////////////
+// 書式化済み名前の永続キャッシュ．
+////////////////////////////////
+// a binary file placed next to the ini file, which stores the formatted captions and their widths.
+// the file is discarded when the formats, the font or the DPI differ from those at saving.
+struct persistent_cache {
+	constexpr static uint32_t magic = 0x4e534452; // "RDSN".
+	constexpr static uint32_t version = 1;
+	constexpr static size_t max_file_size = 16 << 20;
+
+	struct header {
+		uint32_t magic, version;
+		uint64_t key;
+		uint32_t count, reserved;
+	};
+	// followed by the name in the system encoding and the caption in UTF-16,
+	// padded to a multiple of 4 bytes.
+	struct record {
+		uint8_t kind, reserved;
+		uint16_t name_len, caption_len, reserved2;
+		int32_t width;
+	};
+	constexpr static size_t body_size(record const& r) {
+		return (r.name_len + r.caption_len * sizeof(wchar_t) + 3) & ~size_t{ 3 };
+	}
+
+	// calculates the key from the formats, and the current font and DPI.
+	static uint64_t calc_key()
+	{
+		uint64_t hash = measure_context.key; // FNV-1a, continued.
+		auto feed = [&](void const* data, size_t size) {
+			for (auto p = static_cast<byte const*>(data), e = p + size; p < e; p++)
+				hash = (hash ^ *p) * 0x00000100000001b3;
+		};
+		auto feed_int = [&](int32_t val) { feed(&val, sizeof(val)); };
+
+		for (auto* fmt : { &settings.anim_eff_fmt,
+			&settings.cust_std_fmt, &settings.cust_ext_fmt, &settings.cust_particle_fmt,
+			&settings.cam_eff_fmt, &settings.scn_change_fmt }) {
+			if (*fmt) {
+				feed_int(static_cast<int32_t>((*fmt)->size()));
+				feed((*fmt)->c_str(), (*fmt)->size() * sizeof(wchar_t));
+			}
+			else feed_int(-1);
+		}
+		return hash;
+	}
+
+	static void load(wchar_t const* path, uint64_t key)
+	{
+		HANDLE file = ::CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return;
+
+		if (LARGE_INTEGER size; ::GetFileSizeEx(file, &size) != FALSE &&
+			size.QuadPart >= static_cast<int64_t>(sizeof(header)) && size.QuadPart <= max_file_size) {
+			if (HANDLE map = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr); map != nullptr) {
+				if (void const* view = ::MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0); view != nullptr) {
+					parse(static_cast<byte const*>(view), static_cast<size_t>(size.QuadPart), key);
+					::UnmapViewOfFile(view);
+				}
+				::CloseHandle(map);
+			}
+		}
+		::CloseHandle(file);
+	}
+
+	// writes the file only if any of the caches has new entries.
+	// entries measured with other fonts or DPIs than the current are left out.
+	static void save(wchar_t const* path, uint64_t key)
+	{
+		if (std::none_of(std::begin(all_caches), std::end(all_caches),
+			[](auto* cache) { return *cache && (*cache)->modified; })) return;
+
+		header head{ .magic = magic, .version = version, .key = key, .count = 0, .reserved = 0 };
+		std::vector<byte> buf(sizeof(head));
+		for (size_t kind = 0; kind < std::size(all_caches); kind++) {
+			auto& cache = *all_caches[kind];
+			if (!cache) continue;
+			cache->for_each([&](std::string const& name, name_cache const& nc) {
+				if (!nc.is_valid() || !nc.is_current() ||
+					name.size() > 0xffff || nc.caption.size() > 0xffff) return;
+
+				record const rec{
+					.kind = static_cast<uint8_t>(kind), .reserved = 0,
+					.name_len = static_cast<uint16_t>(name.size()),
+					.caption_len = static_cast<uint16_t>(nc.caption.size()),
+					.reserved2 = 0, .width = nc.width,
+				};
+				size_t const pos = buf.size();
+				buf.resize(pos + sizeof(rec) + body_size(rec)); // padding is zero-filled.
+				std::memcpy(&buf[pos], &rec, sizeof(rec));
+				std::memcpy(&buf[pos + sizeof(rec)], name.data(), name.size());
+				std::memcpy(&buf[pos + sizeof(rec) + name.size()], nc.caption.data(), nc.caption.size() * sizeof(wchar_t));
+				head.count++;
+			});
+		}
+		std::memcpy(buf.data(), &head, sizeof(head));
+
+		// write to a temporary file and then replace, so a failure leaves the old file intact.
+		std::wstring const tmp = std::wstring{ path } + L".tmp";
+		HANDLE file = ::CreateFileW(tmp.c_str(), GENERIC_WRITE, 0, nullptr,
+			CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return;
+		DWORD written = 0;
+		bool const ok = ::WriteFile(file, buf.data(), static_cast<DWORD>(buf.size()), &written, nullptr) != FALSE
+			&& written == buf.size();
+		::CloseHandle(file);
+
+		if (ok) ::MoveFileExW(tmp.c_str(), path, MOVEFILE_REPLACE_EXISTING);
+		else ::DeleteFileW(tmp.c_str());
+	}
+
+private:
+	static void parse(byte const* data, size_t size, uint64_t key)
+	{
+		header head;
+		std::memcpy(&head, data, sizeof(head));
+		if (head.magic != magic || head.version != version || head.key != key) return;
+
+		size_t pos = sizeof(head);
+		for (uint32_t i = 0; i < head.count; i++) {
+			record rec;
+			if (pos + sizeof(rec) > size) break;
+			std::memcpy(&rec, data + pos, sizeof(rec));
+			pos += sizeof(rec);
+			if (pos + body_size(rec) > size) break;
+
+			if (rec.kind < std::size(all_caches)) {
+				if (auto& cache = *all_caches[rec.kind]; cache) {
+					std::wstring caption(rec.caption_len, L'\0');
+					std::memcpy(caption.data(), data + pos + rec.name_len, rec.caption_len * sizeof(wchar_t));
+					cache->preload({ reinterpret_cast<char const*>(data + pos), rec.name_len },
+						caption, rec.width);
+				}
+			}
+			pos += body_size(rec);
+		}
+	}
+};
+
 // find or create a cached formatted names at the given filter index of the selected object.
 static inline name_cache const* find_script_name_cache(ExEdit::Object const& obj, size_t filter_index)
 {
-	auto [name, id] = get_script_name(obj, filter_index);
+	auto [name, id, interned] = get_script_name(obj, filter_index);
 	if (name == nullptr) return nullptr;
 
 	cache_manager* cache_source;
@@ -188,7 +522,66 @@ static inline name_cache const* find_script_name_cache(ExEdit::Object const& obj
 		std::unreachable();
 	}
 	return cache_source == nullptr ? nullptr :
-		&cache_source->find_cache(name, filter_index);
+		&cache_source->find_cache(name, interned, filter_index);
+}
+
+// precomputes the caches for the names in the host's tables at idle time,
+// so the first appearance of each script in the setting dialog doesn't wait for measuring.
+static constinit struct precompute_state {
+	constexpr static UINT_PTR timer_id = 0x5c71;
+	constexpr static size_t names_per_slice = 8;
+
+	void start(HWND hwnd)
+	{
+		stage = index = 0;
+		::SetTimer(hwnd, timer_id, USER_TIMER_MINIMUM, &on_timer);
+	}
+	void stop(HWND hwnd) { ::KillTimer(hwnd, timer_id); }
+
+private:
+	size_t stage = 0, index = 0;
+
+	// returns the table and the cache for the current stage, or nullptr for the table when finished.
+	std::pair<decltype(basic_anm_names)*, cache_manager*> current() const
+	{
+		switch (stage) {
+		case 0: return { &basic_anm_names, anim_eff.get() };
+		case 1: return { &basic_obj_names, cust_std.get() };
+		case 2: return { &basic_obj_names, cust_ext.get() };
+		case 3: return { &basic_obj_names, cust_prtcl.get() };
+		case 4: return { &basic_cam_names, cam_eff.get() };
+		case 5: return { &basic_scn_names, scn_change.get() };
+		default: return { nullptr, nullptr };
+		}
+	}
+
+	// processes a slice of names. returns `false` when all names are processed.
+	bool step()
+	{
+		for (size_t n = 0; n < names_per_slice; ) {
+			auto [table, cache] = current();
+			if (table == nullptr) return false;
+			if (cache == nullptr || index >= table->size()) {
+				stage++; index = 0;
+				continue;
+			}
+
+			if (auto name = (*table)[index++]; name != nullptr && *name != '\0') {
+				cache->find_cache(name, true, 0);
+				n++;
+			}
+
+			// yield to user inputs.
+			if ((::GetQueueStatus(QS_INPUT) >> 16) != 0) break;
+		}
+		return true;
+	}
+
+	static void CALLBACK on_timer(HWND hwnd, UINT, UINT_PTR id, DWORD);
+} idle_precompute;
+void CALLBACK precompute_state::on_timer(HWND hwnd, UINT, UINT_PTR id, DWORD)
+{
+	if (!idle_precompute.step()) ::KillTimer(hwnd, id);
 }
 
 static inline size_t filter_index_from_script_combo(size_t id_combo,
@@ -223,44 +616,103 @@ static inline size_t filter_index_from_script_combo(size_t id_combo,
 }
 
 // holding the current states of manipulation of the check buttons and the separators.
-static constinit struct {
-	size_t filter_index = 0;
-	name_cache const* candidate = nullptr;
+// renamed filters are collected during an update of the dialog and re-layout at once.
+static constinit struct layout_state {
+	name_cache const* pending[ExEdit::Object::MAX_FILTER]{};
+	bool setting_text = false; // `true` while this plugin is setting the caption itself.
+
+	struct {
+		// `requests` counts the adjustments that the layout one by one would make,
+		// each of which takes two calls to `MoveWindow()` with repainting.
+		size_t requests = 0, batches = 0, windows_moved = 0;
+		size_t repaints_saved() const { return 2 * requests - std::min(2 * requests, batches); }
+	} stats{};
 
 	constexpr void push(size_t filter_index, name_cache const* candidate) {
-		this->filter_index = filter_index;
-		this->candidate = candidate;
+		pending[filter_index] = candidate;
+		stats.requests++;
 	}
-	constexpr bool is_valid() const { return candidate != nullptr; }
-	constexpr void invalidate() { candidate = nullptr; }
 
-	// adjusts positions and sizes of the check button and the separator.
-	void adjust_layout()
+	// requests `flush()` to be called after the current update of the dialog.
+	void schedule(HWND hwnd);
+	void discard(HWND hwnd)
 	{
-		// the state must be valid.
-		if (!is_valid()) return;
+		std::ranges::fill(pending, nullptr);
+		if (!posted) return;
+		posted = false;
+		discard_message(hwnd, PrivateMsg::RequestCallback);
+	}
 
-		HWND const dlg = *exedit.hwnd_setting_dlg,
-			sep = exedit.filter_separators[filter_index],
-			btn = exedit.filter_checkboxes[filter_index];
+	// adjusts positions and sizes of the pending check buttons and separators in a single batch.
+	void flush()
+	{
+		posted = false;
+
+		HWND const dlg = *exedit.hwnd_setting_dlg;
+		struct placement { HWND hwnd; int x, y, w, h; } moves[2 * std::size(pending)];
+		size_t cnt = 0;
+		RECT rc_update{};
+		for (size_t filter_index = 0; filter_index < std::size(pending); filter_index++) {
+			auto* const candidate = std::exchange(pending[filter_index], nullptr);
+			if (candidate == nullptr) continue;
+
+			HWND const sep = exedit.filter_separators[filter_index],
+				btn = exedit.filter_checkboxes[filter_index];
+
+			// find the positions of the check button and the separator.
+			RECT rc_sep, rc_btn;
+			::GetWindowRect(sep, &rc_sep); ::MapWindowPoints(nullptr, dlg, reinterpret_cast<POINT*>(&rc_sep), 2);
+			::GetWindowRect(btn, &rc_btn); ::MapWindowPoints(nullptr, dlg, reinterpret_cast<POINT*>(&rc_btn), 2);
+
+			// adjust their sizes according to the precalculated width.
+			int const btn_left = rc_btn.right - candidate->wd_button(),
+				btn_top = rc_btn.bottom - candidate->button_height;
+			moves[cnt++] = { btn, btn_left, btn_top, candidate->wd_button(), candidate->button_height };
+			moves[cnt++] = { sep, rc_sep.left, rc_sep.top,
+				std::max<int>(btn_left - candidate->gap_between_sep - rc_sep.left, 0), candidate->sep_height };
+
+			// the area to repaint covers both the old and new positions.
+			RECT const rc_new{ std::min<int>(rc_sep.left, btn_left), std::min<int>(rc_sep.top, btn_top),
+				rc_btn.right, rc_btn.bottom };
+			::UnionRect(&rc_update, &rc_update, &rc_sep);
+			::UnionRect(&rc_update, &rc_update, &rc_btn);
+			::UnionRect(&rc_update, &rc_update, &rc_new);
+		}
+		if (cnt == 0) return;
 
-		// find the positions of the check button and the separator.
-		RECT rc; ::GetWindowRect(sep, &rc);
-		POINT sep_tl{ rc.left, rc.top }; ::ScreenToClient(dlg, &sep_tl);
-		::GetWindowRect(btn, &rc);
-		POINT btn_br{ rc.right, rc.bottom }; ::ScreenToClient(dlg, &btn_br);
+		constexpr UINT flags = SWP_NOZORDER | SWP_NOACTIVATE | SWP_NOREDRAW;
+		HDWP dwp = ::BeginDeferWindowPos(static_cast<int>(cnt));
+		for (size_t i = 0; i < cnt && dwp != nullptr; i++) {
+			auto const& m = moves[i];
+			dwp = ::DeferWindowPos(dwp, m.hwnd, nullptr, m.x, m.y, m.w, m.h, flags);
+		}
+		if (dwp == nullptr || ::EndDeferWindowPos(dwp) == FALSE) {
+			// fall back to moving one by one, still without redrawing each.
+			for (size_t i = 0; i < cnt; i++) {
+				auto const& m = moves[i];
+				::SetWindowPos(m.hwnd, nullptr, m.x, m.y, m.w, m.h, flags);
+			}
+		}
 
-		// adjust their sizes according to the precalculated width.
-		::MoveWindow(btn, btn_br.x - candidate->wd_button(), btn_br.y - candidate->button_height,
-			candidate->wd_button(), candidate->button_height, TRUE);
-		::MoveWindow(sep, sep_tl.x, sep_tl.y,
-			std::max<int>(btn_br.x - candidate->wd_button() - candidate->gap_between_sep - sep_tl.x, 0),
-			candidate->sep_height, TRUE);
+		// then repaint them at once.
+		::RedrawWindow(dlg, &rc_update, nullptr, RDW_INVALIDATE | RDW_ERASE | RDW_ALLCHILDREN);
 
-		// invalidate the state.
-		invalidate();
+		stats.batches++;
+		stats.windows_moved += cnt;
 	}
+
+private:
+	bool posted = false;
 } hook_state;
+void layout_state::schedule(HWND hwnd)
+{
+	if (posted) return;
+	posted = true;
+
+	constexpr PrivateMsg::callback_fnptr callback = [](auto...) { hook_state.flush(); };
+	::PostMessageW(hwnd, PrivateMsg::RequestCallback,
+		{}, reinterpret_cast<LPARAM>(callback));
+}
 
 
 ////////////////////////////////
@@ -271,13 +723,18 @@ static inline LRESULT CALLBACK setting_dlg_hook(HWND hwnd, UINT message, WPARAM
 	auto ret = ::DefSubclassProc(hwnd, message, wparam, lparam);
 
 	switch (message) {
+	case WM_DPICHANGED:
+		// widths are measured again when used.
+		measure_context.update(exedit.filter_checkboxes[0]);
+		break;
+
 	case WM_COMMAND:
 		if (auto ctrl = reinterpret_cast<HWND>(lparam); ctrl != nullptr) {
 			switch (wparam >> 16) {
 				// 選択スクリプトの変更を監視．
 			case CBN_SELCHANGE:
 			{
-				if (hook_state.is_valid()) break;
+				if (hook_state.setting_text) break;
 				auto const idx_obj = *exedit.SettingDialogObjectIndex;
 				if (idx_obj < 0 || !check_window_class(ctrl, WC_COMBOBOXW)) break;
 				auto const& obj = (*exedit.ObjectArray_ptr)[idx_obj];
@@ -291,9 +748,11 @@ static inline LRESULT CALLBACK setting_dlg_hook(HWND hwnd, UINT message, WPARAM
 				if (cache == nullptr) break;
 
 				// then update the filter name and adjust the layout.
-				hook_state.push(filter_index, cache);
+				hook_state.setting_text = true;
 				::SetWindowTextW(exedit.filter_checkboxes[filter_index], cache->caption.c_str());
-				hook_state.adjust_layout();
+				hook_state.setting_text = false;
+				hook_state.push(filter_index, cache);
+				hook_state.flush();
 				break;
 			}
 			}
@@ -317,8 +776,8 @@ static inline LRESULT CALLBACK filter_sep_hook(HWND hwnd, UINT message, WPARAM w
 		::RemoveWindowSubclass(hwnd, &filter_sep_hook, id);
 		if (message != WM_SIZE) break;
 
-		// re-layout at the first call to this function.
-		hook_state.adjust_layout();
+		// re-layout after the dialog finishes updating, together with other filters.
+		hook_state.schedule(hwnd_host);
 		break;
 	}
 	}
@@ -333,7 +792,7 @@ static inline LRESULT CALLBACK filter_name_hook(HWND hwnd, UINT message, WPARAM
 	{
 		// wparam: not used, lparam: reinterpret_cast<wchar_t const*>(lparam) is the new text.
 
-		if (hook_state.is_valid()) break;
+		if (hook_state.setting_text) break;
 		auto const idx_obj = *exedit.SettingDialogObjectIndex;
 		if (idx_obj < 0) break;
 		size_t const filter_idx = static_cast<size_t>(data);
@@ -351,6 +810,14 @@ static inline LRESULT CALLBACK filter_name_hook(HWND hwnd, UINT message, WPARAM
 		break;
 	}
 
+	case WM_SETFONT:
+	{
+		// widths are measured again when used.
+		auto ret = ::DefSubclassProc(hwnd, message, wparam, lparam);
+		measure_context.update(hwnd);
+		return ret;
+	}
+
 	case WM_DESTROY:
 		::RemoveWindowSubclass(hwnd, &filter_name_hook, id);
 		break;
@@ -382,12 +849,46 @@ bool expt::setup(HWND hwnd, bool initializing)
 			basic_cam_names.init(exedit.basic_camera_eff_names);
 			basic_scn_names.init(exedit.basic_scene_change_names);
 
+			measure_context.update(exedit.filter_checkboxes[0]);
+			if (settings.cache_file)
+				persistent_cache::load(settings.cache_file->c_str(), persistent_cache::calc_key());
+
 			::SetWindowSubclass(dlg, &setting_dlg_hook, hook_uid(), {});
 			for (size_t i = 0; i < ExEdit::Object::MAX_FILTER; i++)
 				::SetWindowSubclass(exedit.filter_checkboxes[i], &filter_name_hook,	hook_uid(), { i });
+
+			hwnd_host = hwnd;
+			idle_precompute.start(hwnd);
 		}
 		else {
+			idle_precompute.stop(hwnd);
+			hook_state.discard(hwnd_host);
 			::RemoveWindowSubclass(dlg, &setting_dlg_hook, hook_uid());
+
+			if (settings.cache_file)
+				persistent_cache::save(settings.cache_file->c_str(), persistent_cache::calc_key());
+
+		#ifdef _DEBUG
+			// report the statistics of the caches.
+			std::pair<wchar_t const*, cache_manager const*> const caches[] = {
+				{ L"anim_eff", anim_eff.get() },
+				{ L"cust_std", cust_std.get() }, { L"cust_ext", cust_ext.get() }, { L"cust_prtcl", cust_prtcl.get() },
+				{ L"cam_eff", cam_eff.get() },
+				{ L"scn_change", scn_change.get() },
+			};
+			for (auto [label, cache] : caches) {
+				if (cache == nullptr) continue;
+				wchar_t buf[128];
+				::swprintf_s(buf, L"ScriptName cache %s: %zu entries, %zu hits, %zu misses, %zu bytes\n",
+					label, cache->count(), cache->stats.hits, cache->stats.misses, cache->memory_usage());
+				::OutputDebugStringW(buf);
+			}
+			wchar_t buf[128];
+			::swprintf_s(buf, L"ScriptName layout: %zu requests, %zu windows moved in %zu batches, %zu repaints saved\n",
+				hook_state.stats.requests, hook_state.stats.windows_moved, hook_state.stats.batches,
+				hook_state.stats.repaints_saved());
+			::OutputDebugStringW(buf);
+		#endif // _DEBUG
 		}
 		return true;
 	}
@@ -409,6 +910,13 @@ void expt::Settings::load(char const* ini_file)
 	read(scn_change_fmt);
 
 #undef read
+
+	if (read_ini_bool(false, ini_file, section, "persist_cache")) {
+		// placed next to the ini file, replacing its extension.
+		std::wstring path = encode_sys::to_wide_str(ini_file);
+		if (auto pos = path.find_last_of(L'.'); pos != std::wstring::npos) path.resize(pos);
+		cache_file = std::make_unique<std::wstring>(path + L".names.bin");
+	}
 }
 
 void expt::Settings::check_conflict(char const* this_plugin_name)
@@ -32,6 +32,7 @@ namespace reactive_dlg::Filters::ScriptName
 			cust_std_fmt{}, cust_ext_fmt{}, cust_particle_fmt{},
 			cam_eff_fmt{},
 			scn_change_fmt{};
+		std::unique_ptr<std::wstring> cache_file{}; // path to the persistent cache, or null if disabled.
 
 		void load(char const* ini_file);
 		void check_conflict(char const* this_plugin_name);
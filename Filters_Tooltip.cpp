@@ -12,7 +12,12 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 
 #include <cstdint>
 #include <cmath>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <regex>
 #include <bit>
 
 #define NOMINMAX
@@ -26,6 +31,9 @@ using byte = uint8_t;
 
 #include "inifile_op.hpp"
 #include "str_encodes.hpp"
+#include "text_scan.hpp"
+#include "slim_formatter.hpp"
+#include "exdata_rule.hpp"
 #include "monitors.hpp"
 
 #include "reactive_dlg.hpp"
@@ -298,26 +306,21 @@ static inline bool parse_as_text(std::wstring& s, ExEdit::ExdataUse const*& use,
 {
 	using Type = ExEdit::ExdataUse::Type;
 	constexpr static std::string_view token_text = "text";
-	constexpr static std::wstring_view text_ellipsis = L"...", line_breaks = L"\r\n";
+	constexpr static std::wstring_view text_ellipsis = L"...";
 	constexpr static size_t min_size_text = 256, max_heading_chars = 64;
 
 	if (use->name == token_text &&
 		use->size >= min_size_text && use->size % sizeof(wchar_t) == 0 &&
 		use->type == Type::Binary) {
 
-		std::wstring_view text{ reinterpret_cast<wchar_t const*>(data), use->size / sizeof(wchar_t) };
-		text = text.substr(0, text.find_first_of(L'\0'));
-
-		// trim the line breaks.
-		if (auto pos = text.find_first_not_of(line_breaks); pos != text.npos)
-			text = text.substr(pos);
-		if (auto pos = text.find_last_not_of(line_breaks); pos != text.npos)
-			text = text.substr(0, pos + 1);
+		// find the terminator and trim the line breaks in a single scan.
+		auto const* const text = reinterpret_cast<wchar_t const*>(data);
+		auto const scan = sigma_lib::string::scan_text(text, use->size / sizeof(wchar_t), max_heading_chars);
 
 		// leave only non-empty text.
-		if (!text.empty()) {
-			s.append(text.substr(0, max_heading_chars));
-			if (text.size() > max_heading_chars) s.append(text_ellipsis);
+		if (!scan.empty()) {
+			s.append(scan.heading(text));
+			if (scan.truncated()) s.append(text_ellipsis);
 
 			return next_exdata(use, data, size_remain);
 		}
@@ -328,9 +331,7 @@ static inline bool parse_as_text(std::wstring& s, ExEdit::ExdataUse const*& use,
 static inline bool parse_as_scene(std::wstring& s, ExEdit::ExdataUse const*& use, byte const*& data, int& size_remain)
 {
 	using Type = ExEdit::ExdataUse::Type;
-	using sigma_lib::string::encode_sys;
 	constexpr static std::string_view token_scene = "scene";
-	constexpr static int max_scenes = 50;
 
 	if (use->name == token_scene &&
 		use->size == 4 &&
@@ -339,24 +340,91 @@ static inline bool parse_as_scene(std::wstring& s, ExEdit::ExdataUse const*& use
 		int n = *reinterpret_cast<int const*>(data);
 		s.append(L"シーン: ");
 
-		// compose the scene name.
-		std::wstring scene_name{};
-		if (0 <= n && n < max_scenes) {
-			if (n == 0) scene_name = L"Root";
-			else {
-				wchar_t buf[16];
-				scene_name = { buf, static_cast<size_t>(::swprintf_s(buf, L"Scene %d", n)) };
+		// take the scene name from the shared table.
+		if (auto const scene_name = scene_display_name(n); !scene_name.empty())
+			s.append(scene_name);
+		else s.append(L"(指定なし)");
+
+		return next_exdata(use, data, size_remain);
+	}
+	return false;
+}
+
+// user-defined formatters of exdata, compiled from the ini file.
+using exdata_rule = sigma_lib::exdata::rule;
+static struct {
+	std::vector<exdata_rule> rules{};
+
+	// finds the first matching rule. results are cached as `ExdataUse` are static in each filter.
+	std::pair<exdata_rule const*, std::wstring const*> find(ExEdit::ExdataUse const* use)
+	{
+		auto [it, inserted] = matches.try_emplace(use);
+		auto& m = it->second;
+		if (inserted) {
+			m.name = sigma_lib::string::encode_sys::to_wide_str(use->name);
+			for (auto const& rule : rules) {
+				if (rule.matches(use->size, static_cast<int32_t>(use->type), m.name)) {
+					m.rule = &rule;
+					break;
+				}
 			}
+		}
+		return { m.rule, &m.name };
+	}
 
-			// if it has a custom name, place it at the head.
-			if (auto const* name = exedit.scene_settings[n].name;
-				name != nullptr && name[0] != '\0')
-				scene_name = encode_sys::to_wide_str(name)
-					+ L" (" + scene_name + L")";
+	void load(char const* ini_file)
+	{
+		using namespace sigma_lib::inifile;
+		using Type = ExEdit::ExdataUse::Type;
+
+		constexpr auto section = "Filters.Tooltip.Exdata";
+		constexpr size_t max_str_len = 255, max_rules = 64;
+
+		rules.clear(); matches.clear();
+		for (size_t i = 1; i <= max_rules; i++) {
+			char key[32];
+			auto read_str = [&](char const* field) {
+				::sprintf_s(key, "%zu.%s", i, field);
+				return read_ini_string(u8"", ini_file, section, key, max_str_len);
+			};
+			auto read_int = [&](char const* field, int32_t def, int32_t min, int32_t max) {
+				::sprintf_s(key, "%zu.%s", i, field);
+				return read_ini_int(def, ini_file, section, key, min, max);
+			};
+
+			// rules are numbered from 1, terminated by the first missing name.
+			auto pattern = read_str("name");
+			if (pattern.empty()) break;
+
+			auto rule = exdata_rule::parse(pattern, read_str, read_int, [](std::wstring const& type) {
+				if (type == L"number") return static_cast<int32_t>(Type::Number);
+				if (type == L"binary") return static_cast<int32_t>(Type::Binary);
+				if (type == L"string") return static_cast<int32_t>(Type::String);
+				return exdata_rule::any_type;
+			});
+			if (!rule) continue;
+
+			rules.push_back(std::move(*rule));
 		}
-		else scene_name = L"(指定なし)";
-		s.append(scene_name);
+		rules.shrink_to_fit();
+	}
 
+private:
+	struct match {
+		exdata_rule const* rule = nullptr;
+		std::wstring name{};
+	};
+	std::unordered_map<ExEdit::ExdataUse const*, match> matches{};
+} exdata_rules;
+
+static inline bool parse_by_rules(std::wstring& s, ExEdit::ExdataUse const*& use, byte const*& data, int& size_remain)
+{
+	if (exdata_rules.rules.empty()) return false;
+
+	if (auto const [rule, name] = exdata_rules.find(use); rule != nullptr) {
+		rule->append(s, *name, data, use->size, [](std::string_view str) {
+			return sigma_lib::string::encode_sys::to_wide_str(str);
+		});
 		return next_exdata(use, data, size_remain);
 	}
 	return false;
@@ -374,7 +442,8 @@ static inline std::wstring format_exdata(size_t filter_index, ExEdit::Object con
 	std::wstring ret = L"";
 	while (size_remain > 0 && use->size <= size_remain) {
 		if (use->name != nullptr && use->type != ExEdit::ExdataUse::Type::Padding) {
-			if (parse_as_file(ret, use, data, size_remain) ||
+			if (parse_by_rules(ret, use, data, size_remain) ||
+				parse_as_file(ret, use, data, size_remain) ||
 				parse_as_color(ret, use, data, size_remain) ||
 				parse_as_color_yc(ret, use, data, size_remain) ||
 				parse_as_blend(ret, use, data, size_remain) ||
@@ -595,4 +664,6 @@ void expt::Settings::load(char const* ini_file)
 
 #undef read_s
 #undef read
+
+	if (exdata) exdata_rules.load(ini_file);
 }
@@ -13,12 +13,19 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 #pragma once
 
 #include <cstdint>
+#include <climits>
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
+#include <span>
 
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
+#include "line_breaks.hpp"
+
 ////////////////////////////////
 // Windows API 利用の補助関数．
 ////////////////////////////////
@@ -49,27 +56,114 @@ namespace sigma_lib::W32
 
 			return success;
 		}
+		// line breaks are converted to CRLF, as specified in Win32 API docs.
 		static void write(std::wstring_view const& src)
+		{
+			write(string::crlf_length(src), [&](wchar_t* dst) -> size_t {
+				return string::copy_crlf(src, dst) - dst;
+			});
+		}
+		// writes a multi-byte string, converted into UTF-16 directly in the global memory.
+		// line breaks are converted to CRLF in place.
+		static void write(std::string_view const& src, uint32_t code_page)
+		{
+			if (src.size() > INT_MAX) return;
+			int const cnt_src = static_cast<int>(src.size()),
+				cnt_wide = cnt_src == 0 ? 0 : ::MultiByteToWideChar(code_page, 0, src.data(), cnt_src, nullptr, 0);
+			// CR and LF are never part of double-byte characters, so they're counted in the source.
+			size_t const cnt_crs = string::crlf_length(src) - src.size();
+
+			write(cnt_wide + cnt_crs, [&](wchar_t* dst) -> size_t {
+				size_t const len = cnt_wide == 0 ? 0 :
+					::MultiByteToWideChar(code_page, 0, src.data(), cnt_src, dst, cnt_wide);
+				return string::expand_crlf(dst, len, cnt_wide + cnt_crs);
+			});
+		}
+		// allocates the global memory for a text of `len` characters,
+		// and lets `fill(wchar_t* dst) -> size_t` write the text directly, returning the written length.
+		// the null terminator is added afterwards.
+		static bool write(size_t len, auto&& fill)
 		{
 			// initializing.
-			if (::OpenClipboard(nullptr) == FALSE) return;
+			if (::OpenClipboard(nullptr) == FALSE) return false;
 			::EmptyClipboard();
 
+			bool const success = set_text(len, fill);
+
+			// finalizing.
+			::CloseClipboard();
+			return success;
+		}
+		// writes a text along with binary data in a private format, at once.
+		// line breaks in the text are converted to CRLF.
+		static bool write(std::wstring_view const& src, uint32_t format, std::span<std::byte const> data)
+		{
+			// initializing.
+			if (::OpenClipboard(nullptr) == FALSE) return false;
+			::EmptyClipboard();
+
+			bool const success = set_text(string::crlf_length(src), [&](wchar_t* dst) -> size_t {
+				return string::copy_crlf(src, dst) - dst;
+			}) && set_data(format, data);
+
+			// finalizing.
+			::CloseClipboard();
+			return success;
+		}
+		// reads binary data in a private format.
+		static bool read(uint32_t format, std::vector<std::byte>& dst)
+		{
+			if (format == 0 || ::IsClipboardFormatAvailable(format) == FALSE ||
+				::OpenClipboard(nullptr) == FALSE) return false;
+
+			bool success = false;
+			if (auto h = ::GetClipboardData(format); h != nullptr) {
+				if (auto ptr = reinterpret_cast<std::byte const*>(::GlobalLock(h)); ptr != nullptr) {
+					dst.assign(ptr, ptr + ::GlobalSize(h));
+					::GlobalUnlock(h);
+
+					success = true;
+				}
+			}
+
+			::CloseClipboard();
+			return success;
+		}
+
+	private:
+		// the clipboard must be open and owned.
+		static bool set_text(size_t len, auto&& fill)
+		{
 			// allocate global memory to store the string.
-			if (auto h = ::GlobalAlloc(GMEM_MOVEABLE, sizeof(wchar_t) * (src.size() + 1)); h != nullptr) {
+			bool success = false;
+			if (auto h = ::GlobalAlloc(GMEM_MOVEABLE, sizeof(wchar_t) * (len + 1)); h != nullptr) {
 				if (auto ptr = reinterpret_cast<wchar_t*>(::GlobalLock(h)); ptr != nullptr) {
-					// copy the string to the global memory.
-					src.copy(ptr, src.size()); ptr[src.size()] = L'\0';
+					// let the producer write to the global memory.
+					ptr[std::min<size_t>(fill(ptr), len)] = L'\0';
 					::GlobalUnlock(h);
 
 					// send to the clipboard.
-					::SetClipboardData(CF_UNICODETEXT, h);
+					success = ::SetClipboardData(CF_UNICODETEXT, h) != nullptr;
 				}
-				else ::GlobalFree(h);
+				if (!success) ::GlobalFree(h);
 			}
+			return success;
+		}
+		static bool set_data(uint32_t format, std::span<std::byte const> data)
+		{
+			if (format == 0) return false;
 
-			// finalizing.
-			::CloseClipboard();
+			bool success = false;
+			if (auto h = ::GlobalAlloc(GMEM_MOVEABLE, std::max<size_t>(data.size(), 1)); h != nullptr) {
+				if (auto ptr = ::GlobalLock(h); ptr != nullptr) {
+					std::memcpy(ptr, data.data(), data.size());
+					::GlobalUnlock(h);
+
+					success = ::SetClipboardData(format, h) != nullptr;
+				}
+				if (!success) ::GlobalFree(h);
+			}
+			return success;
 		}
 	};
 }
@@ -0,0 +1,166 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <cwchar>
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "text_scan.hpp"
+#include "slim_formatter.hpp"
+
+////////////////////////////////
+// 拡張データの書式規則．
+////////////////////////////////
+namespace sigma_lib::exdata
+{
+	// a user-defined formatter of an exdata entry.
+	struct rule {
+		enum class format : uint8_t {
+			hex, signed_int, unsigned_int, fixed, enumeration, string,
+		};
+		constexpr static int32_t any_type = -1;
+
+		std::wregex name;
+		int32_t size;	// required size of the exdata in bytes. 0 for any.
+		int32_t type;	// required type of the exdata, or `any_type`.
+		format fmt;
+		int32_t scale;	// the denominator for `format::fixed`.
+		std::vector<std::wstring> labels; // the names for `format::enumeration`.
+		std::unique_ptr<sigma_lib::string::slim_formatter> text; // null to show "name: value".
+
+		bool matches(int32_t use_size, int32_t use_type, std::wstring const& use_name) const
+		{
+			return (size == 0 || size == use_size) &&
+				(type == any_type || type == use_type) &&
+				std::regex_match(use_name, name);
+		}
+
+		/// formats an exdata entry and appends it to `s`.
+		/// @param decode converts a string in the system encoding into a wide string.
+		void append(std::wstring& s, std::wstring const& use_name, uint8_t const* data, int32_t use_size, auto&& decode) const
+		{
+			// format the value.
+			std::wstring val{};
+			wchar_t buf[32];
+			switch (fmt) {
+			case format::hex:
+			{
+				constexpr int max_bytes = 16;
+				for (int i = 0, N = std::min(use_size, max_bytes); i < N; i++)
+					val.append(buf, std::swprintf(buf, std::size(buf), L"%02x", data[i]));
+				if (use_size > max_bytes) val.append(L"...");
+				break;
+			}
+			case format::string:
+			{
+				auto const* const str = reinterpret_cast<char const*>(data);
+				val = decode(std::string_view{ str,
+					sigma_lib::string::bounded_length(str, static_cast<size_t>(use_size)) });
+				break;
+			}
+			case format::unsigned_int:
+				val.assign(buf, std::swprintf(buf, std::size(buf), L"%llu",
+					static_cast<unsigned long long>(read_integer(data, use_size, false))));
+				break;
+			default:
+			{
+				int64_t const n = static_cast<int64_t>(read_integer(data, use_size, true));
+				switch (fmt) {
+				case format::signed_int:
+					val.assign(buf, std::swprintf(buf, std::size(buf), L"%lld", static_cast<long long>(n)));
+					break;
+				case format::fixed:
+					val.assign(buf, std::swprintf(buf, std::size(buf), L"%.*f",
+						static_cast<int>(std::lround(std::ceil(std::log10(static_cast<double>(scale))))),
+						static_cast<double>(n) / scale));
+					break;
+				case format::enumeration:
+					if (0 <= n && n < static_cast<int64_t>(labels.size())) val = labels[static_cast<size_t>(n)];
+					else val.assign(buf, std::swprintf(buf, std::size(buf), L"%lld", static_cast<long long>(n)));
+					break;
+				default: std::unreachable();
+				}
+				break;
+			}
+			}
+
+			// apply the template.
+			if (text) s.append((*text)(val));
+			else s.append(use_name).append(L": ").append(val);
+		}
+
+		/// compiles a rule from its settings.
+		/// @param read_str returns the string of the given field, or empty if missing.
+		/// @param read_int returns the integer of the given field: `(field, default, min, max)`.
+		/// @param type_of converts the name of the type into its value, or `any_type` if unknown.
+		/// @return the rule, or `std::nullopt` if the pattern of the name is invalid.
+		static std::optional<rule> parse(std::wstring const& pattern, auto&& read_str, auto&& read_int, auto&& type_of)
+		{
+			rule ret{
+				.size = read_int("size", 0, 0, 1 << 16),
+				.type = any_type,
+				.fmt = format::signed_int,
+				.scale = read_int("scale", 100, 1, 1'000'000),
+			};
+
+			// the pattern of the name must be a valid regular expression.
+			try { ret.name.assign(pattern, std::regex::ECMAScript | std::regex::optimize); }
+			catch (std::regex_error const&) { return std::nullopt; }
+
+			ret.type = type_of(read_str("type"));
+
+			using enum format;
+			if (auto const fmt = read_str("format"); fmt == L"hex") ret.fmt = hex;
+			else if (fmt == L"uint") ret.fmt = unsigned_int;
+			else if (fmt == L"fixed") ret.fmt = fixed;
+			else if (fmt == L"enum") ret.fmt = enumeration;
+			else if (fmt == L"string") ret.fmt = string;
+
+			// enumeration labels are separated by commas.
+			if (ret.fmt == enumeration) {
+				auto const list = read_str("labels");
+				for (size_t pos = 0; pos <= list.size(); ) {
+					size_t const end = std::min(list.find(L',', pos), list.size());
+					ret.labels.emplace_back(list, pos, end - pos);
+					pos = end + 1;
+				}
+			}
+
+			if (auto text = read_str("text"); !text.empty())
+				ret.text = std::make_unique<sigma_lib::string::slim_formatter>(text);
+
+			return ret;
+		}
+
+	private:
+		// reads a little endian integer of at most 8 bytes.
+		static uint64_t read_integer(uint8_t const* data, int32_t size, bool is_signed)
+		{
+			uint64_t n = 0;
+			size = std::clamp<int32_t>(size, 0, sizeof(n));
+			for (int32_t i = size; --i >= 0; ) n = (n << 8) | data[i];
+			if (is_signed && 0 < size && size < static_cast<int32_t>(sizeof(n)) &&
+				(data[size - 1] & 0x80) != 0)
+				n |= ~uint64_t{} << (8 * size); // sign extension.
+			return n;
+		}
+	};
+}
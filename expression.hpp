@@ -0,0 +1,265 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <charconv>
+#include <span>
+#include <string>
+#include <vector>
+
+////////////////////////////////
+// 数式の解析と評価．
+////////////////////////////////
+namespace sigma_lib::expression
+{
+	// an arithmetic expression compiled into a sequence of stack operations.
+	// supports numbers, variables, `+ - * / % ^`, parentheses and the functions listed in `functions`.
+	class program {
+		enum class op : uint8_t {
+			push_const, push_var,
+			neg, add, sub, mul, div, mod, pow,
+			abs, floor, ceil, round, sqrt, exp, log, sin, cos, tan,
+			min, max, atan2,
+			lerp, clamp,
+		};
+		struct instr {
+			op code;
+			uint32_t var;
+			double val;
+		};
+		struct function {
+			std::wstring_view name;
+			op code;
+			int arity;
+		};
+		constexpr static function functions[] = {
+			{ L"abs", op::abs, 1 }, { L"floor", op::floor, 1 }, { L"ceil", op::ceil, 1 },
+			{ L"round", op::round, 1 }, { L"sqrt", op::sqrt, 1 }, { L"exp", op::exp, 1 },
+			{ L"log", op::log, 1 }, { L"sin", op::sin, 1 }, { L"cos", op::cos, 1 }, { L"tan", op::tan, 1 },
+			{ L"min", op::min, 2 }, { L"max", op::max, 2 }, { L"pow", op::pow, 2 }, { L"atan2", op::atan2, 2 },
+			{ L"lerp", op::lerp, 3 }, { L"clamp", op::clamp, 3 },
+		};
+
+		std::vector<instr> code{};
+		size_t depth = 0;
+
+		// the limit of nesting of parentheses, signs and function calls,
+		// keeping the recursion of the parser within a small stack.
+		constexpr static size_t max_nesting = 128;
+
+		// recursive-descent parser emitting the instructions in postfix order.
+		struct parser {
+			std::wstring_view src;
+			std::span<std::wstring_view const> vars;
+			program& prog;
+			size_t pos = 0, curr_depth = 0, nesting = 0;
+
+			constexpr static bool is_ident_head(wchar_t c) { return (L'a' <= c && c <= L'z') || (L'A' <= c && c <= L'Z') || c == L'_'; }
+			constexpr static bool is_digit(wchar_t c) { return L'0' <= c && c <= L'9'; }
+
+			wchar_t peek()
+			{
+				while (pos < src.size() && (src[pos] == L' ' || src[pos] == L'\t' ||
+					src[pos] == L'\r' || src[pos] == L'\n')) pos++;
+				return pos < src.size() ? src[pos] : L'\0';
+			}
+			bool eat(wchar_t c)
+			{
+				if (peek() != c) return false;
+				pos++;
+				return true;
+			}
+			// tracks the stack depth: `delta` is the net change by the instruction.
+			void emit(op code, int delta, uint32_t var = 0, double val = 0)
+			{
+				prog.code.push_back({ code, var, val });
+				curr_depth += delta;
+				prog.depth = std::max(prog.depth, curr_depth);
+			}
+
+			// guards a level of the recursion; fails if the nesting is too deep.
+			struct nest {
+				size_t& nesting;
+				bool const ok;
+				nest(size_t& counter) : nesting{ ++counter }, ok{ counter <= max_nesting } {}
+				~nest() { nesting--; }
+			};
+
+			bool expr()
+			{
+				if (!term()) return false;
+				while (true) {
+					if (eat(L'+')) { if (!term()) return false; emit(op::add, -1); }
+					else if (eat(L'-')) { if (!term()) return false; emit(op::sub, -1); }
+					else return true;
+				}
+			}
+			bool term()
+			{
+				if (!unary()) return false;
+				while (true) {
+					if (eat(L'*')) { if (!unary()) return false; emit(op::mul, -1); }
+					else if (eat(L'/')) { if (!unary()) return false; emit(op::div, -1); }
+					else if (eat(L'%')) { if (!unary()) return false; emit(op::mod, -1); }
+					else return true;
+				}
+			}
+			bool unary()
+			{
+				if (eat(L'-')) {
+					if (nest n{ nesting }; !n.ok || !unary()) return false;
+					emit(op::neg, 0);
+					return true;
+				}
+				if (eat(L'+')) {
+					nest n{ nesting };
+					return n.ok && unary();
+				}
+				return power();
+			}
+			bool power()
+			{
+				if (!primary()) return false;
+				// right associative, binding tighter than the unary minus on its left.
+				if (eat(L'^')) {
+					if (nest n{ nesting }; !n.ok || !unary()) return false;
+					emit(op::pow, -1);
+				}
+				return true;
+			}
+			bool primary()
+			{
+				wchar_t const c = peek();
+				if (c == L'(') {
+					pos++;
+					nest n{ nesting };
+					return n.ok && expr() && eat(L')');
+				}
+				if (is_digit(c) || c == L'.') return number();
+				if (is_ident_head(c)) return identifier();
+				return false;
+			}
+			bool number()
+			{
+				// the digits are ASCII, so narrow them for std::from_chars().
+				char buf[64]; size_t len = 0;
+				for (; pos < src.size() && len < std::size(buf); pos++, len++) {
+					wchar_t const c = src[pos];
+					if (is_digit(c) || c == L'.') buf[len] = static_cast<char>(c);
+					else if ((c == L'e' || c == L'E') && len > 0) {
+						buf[len] = 'e';
+						if (pos + 1 < src.size() && (src[pos + 1] == L'+' || src[pos + 1] == L'-') && len + 1 < std::size(buf))
+							buf[++len] = static_cast<char>(src[++pos]);
+					}
+					else break;
+				}
+				double val;
+				if (auto [p, ec] = std::from_chars(buf, buf + len, val); ec != std::errc{} || p != buf + len)
+					return false;
+				emit(op::push_const, +1, 0, val);
+				return true;
+			}
+			bool identifier()
+			{
+				size_t const start = pos;
+				while (pos < src.size() && (is_ident_head(src[pos]) || is_digit(src[pos]))) pos++;
+				auto const name = src.substr(start, pos - start);
+
+				// function call.
+				if (peek() == L'(') {
+					auto const fn = std::ranges::find(functions, name, &function::name);
+					if (fn == std::end(functions)) return false;
+					pos++;
+					nest n{ nesting };
+					if (!n.ok) return false;
+					for (int i = 0; i < fn->arity; i++) {
+						if (i > 0 && !eat(L',')) return false;
+						if (!expr()) return false;
+					}
+					if (!eat(L')')) return false;
+					emit(fn->code, 1 - fn->arity);
+					return true;
+				}
+
+				// variable.
+				auto const var = std::ranges::find(vars, name);
+				if (var == vars.end()) return false;
+				emit(op::push_var, +1, static_cast<uint32_t>(var - vars.begin()));
+				return true;
+			}
+		};
+
+	public:
+		/// compiles an expression.
+		/// @param src the source text of the expression.
+		/// @param vars the names of variables available in the expression.
+		/// the position in this list is the index into the values passed to `eval()`.
+		/// @return the compiled program, which is empty if the source has syntax errors
+		/// or nests deeper than `max_nesting`.
+		static program compile(std::wstring_view src, std::span<std::wstring_view const> vars)
+		{
+			program ret{};
+			parser p{ .src = src, .vars = vars, .prog = ret };
+			if (!p.expr() || p.peek() != L'\0') return {};
+			return ret;
+		}
+
+		bool empty() const { return code.empty(); }
+		// the number of elements that `eval()` requires for its working stack.
+		size_t stack_size() const { return depth; }
+
+		/// evaluates the expression.
+		/// @param vars the values of the variables, in the order given to `compile()`.
+		/// @param stack the working area of at least `stack_size()` elements.
+		double eval(std::span<double const> vars, double* stack) const
+		{
+			double* sp = stack; // points to the next free slot.
+			for (auto const& [c, var, val] : code) {
+				switch (c) {
+				case op::push_const:	*sp++ = val; break;
+				case op::push_var:		*sp++ = vars[var]; break;
+
+				case op::neg:	sp[-1] = -sp[-1]; break;
+				case op::add:	sp--; sp[-1] += sp[0]; break;
+				case op::sub:	sp--; sp[-1] -= sp[0]; break;
+				case op::mul:	sp--; sp[-1] *= sp[0]; break;
+				case op::div:	sp--; sp[-1] /= sp[0]; break;
+				case op::mod:	sp--; sp[-1] = std::fmod(sp[-1], sp[0]); break;
+				case op::pow:	sp--; sp[-1] = std::pow(sp[-1], sp[0]); break;
+
+				case op::abs:	sp[-1] = std::abs(sp[-1]); break;
+				case op::floor:	sp[-1] = std::floor(sp[-1]); break;
+				case op::ceil:	sp[-1] = std::ceil(sp[-1]); break;
+				case op::round:	sp[-1] = std::round(sp[-1]); break;
+				case op::sqrt:	sp[-1] = std::sqrt(sp[-1]); break;
+				case op::exp:	sp[-1] = std::exp(sp[-1]); break;
+				case op::log:	sp[-1] = std::log(sp[-1]); break;
+				case op::sin:	sp[-1] = std::sin(sp[-1]); break;
+				case op::cos:	sp[-1] = std::cos(sp[-1]); break;
+				case op::tan:	sp[-1] = std::tan(sp[-1]); break;
+
+				case op::min:	sp--; sp[-1] = std::min(sp[-1], sp[0]); break;
+				case op::max:	sp--; sp[-1] = std::max(sp[-1], sp[0]); break;
+				case op::atan2:	sp--; sp[-1] = std::atan2(sp[-1], sp[0]); break;
+
+				case op::lerp:	sp -= 2; sp[-1] = sp[-1] + (sp[0] - sp[-1]) * sp[1]; break;
+				case op::clamp:	sp -= 2; sp[-1] = std::min(std::max(sp[-1], sp[0]), sp[1]); break;
+				}
+			}
+			return sp[-1];
+		}
+	};
+}
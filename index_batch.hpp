@@ -0,0 +1,60 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <execution>
+#include <span>
+#include <vector>
+
+////////////////////////////////
+// 添字集合の一括処理．
+////////////////////////////////
+namespace sigma_lib::batch
+{
+	/// collects the distinct keys of the given indices, in ascending order.
+	/// @param first the index whose key is always included.
+	/// @param indices the indices, possibly duplicated or mapped to the same key.
+	/// @param capacity the expected upper bound of the keys, sizing the bitmap.
+	/// @param key_of maps an index into its key, such as the leader of its chain.
+	inline std::vector<size_t> distinct_keys(size_t first, std::span<int const> indices, size_t capacity, auto&& key_of)
+	{
+		// mark the keys on a bitmap over the indices, which sorts and deduplicates them at once.
+		std::vector<bool> marks(std::max(capacity, key_of(first) + 1));
+		size_t count = 0;
+		auto const mark = [&](size_t key) {
+			if (key >= marks.size()) marks.resize(key + 1);
+			if (!marks[key]) { marks[key] = true; count++; }
+		};
+		mark(key_of(first));
+		for (int i : indices) mark(key_of(static_cast<size_t>(i)));
+
+		std::vector<size_t> ret; ret.reserve(count);
+		for (size_t i = 0; ret.size() < count; i++) {
+			if (marks[i]) ret.push_back(i);
+		}
+		return ret;
+	}
+
+	/// calls `func(elem, k)` for each element of `range`, with `k` its position.
+	/// the calls run in parallel when the range has at least `parallel_threshold` elements,
+	/// so each call must only touch its own element and read-only states.
+	inline void for_each_indexed(auto& range, auto&& func, size_t parallel_threshold)
+	{
+		auto const body = [&](auto& elem) { func(elem, static_cast<size_t>(&elem - range.data())); };
+		if (range.size() >= parallel_threshold)
+			std::for_each(std::execution::par, range.begin(), range.end(), body);
+		else std::for_each(range.begin(), range.end(), body);
+	}
+}
@@ -0,0 +1,67 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <string>
+
+////////////////////////////////
+// 改行コードの変換．
+////////////////////////////////
+namespace sigma_lib::string
+{
+	// counts the length of the text after LFs not preceded by CR are turned into CRLF.
+	template<class CharT>
+	inline size_t crlf_length(std::basic_string_view<CharT> src)
+	{
+		size_t len = src.size();
+		for (size_t pos = 0; (pos = src.find(CharT('\n'), pos)) != src.npos; pos++) {
+			if (pos == 0 || src[pos - 1] != CharT('\r')) len++;
+		}
+		return len;
+	}
+	// copies the text turning LFs not preceded by CR into CRLF, in a single pass.
+	// `dst` must have the room of `crlf_length(src)` characters.
+	// returns the end of the written text.
+	template<class CharT>
+	inline CharT* copy_crlf(std::basic_string_view<CharT> src, CharT* dst)
+	{
+		for (size_t pos = 0;;) {
+			size_t const lf = src.find(CharT('\n'), pos);
+			if (lf == src.npos) return std::copy(src.begin() + pos, src.end(), dst);
+
+			dst = std::copy(src.begin() + pos, src.begin() + lf, dst);
+			if (lf == 0 || src[lf - 1] != CharT('\r')) *(dst++) = CharT('\r');
+			*(dst++) = CharT('\n');
+			pos = lf + 1;
+		}
+	}
+	// turns LFs not preceded by CR into CRLF in place, working backwards from the end.
+	// `buf` has the room of `capacity` characters. returns the new length,
+	// or `len` unchanged if the room is insufficient.
+	template<class CharT>
+	inline size_t expand_crlf(CharT* buf, size_t len, size_t capacity)
+	{
+		size_t const total = crlf_length(std::basic_string_view<CharT>{ buf, len });
+		if (total > capacity) return len;
+
+		for (size_t src = len, dst = total; dst > src; ) {
+			CharT const c = buf[--src];
+			buf[--dst] = c;
+			if (c == CharT('\n') && (src == 0 || buf[src - 1] != CharT('\r')))
+				buf[--dst] = CharT('\r');
+		}
+		return total;
+	}
+}
@@ -0,0 +1,162 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <bit>
+#include <string>
+
+#include "text_scan.hpp" // for `SIGMA_LIB_TEXT_SCAN_SSE2`.
+
+////////////////////////////////
+// Lua コード片の文字列エスケープ．
+////////////////////////////////
+namespace sigma_lib::lua
+{
+	// classification of each byte for escaping.
+	enum char_class : uint8_t {
+		plain = 0,
+		escape = 1 << 0,	// must be escaped.
+		lead = 1 << 1,		// lead byte of a double-byte character in the system code page.
+	};
+	using char_class_table = std::array<uint8_t, 256>;
+
+	/// builds the table of classes.
+	/// @param is_lead_byte tells whether the byte is a lead byte of a double-byte character.
+	inline char_class_table make_char_classes(auto&& is_lead_byte)
+	{
+		char_class_table ret{};
+		for (size_t i = 0; i < ret.size(); i++) {
+			if (i <= 0x1f || i == '\\' || i == '"') ret[i] |= escape;
+			if (is_lead_byte(static_cast<uint8_t>(i))) ret[i] |= lead;
+		}
+		return ret;
+	}
+
+	// finds the first byte at or after `pos` that is not a plain ASCII character.
+	inline size_t skip_plain(std::string_view const& str, size_t pos, char_class_table const& classes)
+	{
+	#ifdef SIGMA_LIB_TEXT_SCAN_SSE2
+		// 0x20--0x7f except backslash and double quote; bytes over 0x7f are negative.
+		__m128i const ctrl = ::_mm_set1_epi8(0x1f),
+			bs = ::_mm_set1_epi8('\\'), dq = ::_mm_set1_epi8('"');
+		for (; pos + 16 <= str.size(); pos += 16) {
+			__m128i const v = ::_mm_loadu_si128(reinterpret_cast<__m128i const*>(str.data() + pos));
+			uint32_t const mask_plain = static_cast<uint32_t>(::_mm_movemask_epi8(
+				::_mm_andnot_si128(::_mm_or_si128(::_mm_cmpeq_epi8(v, bs), ::_mm_cmpeq_epi8(v, dq)),
+					::_mm_cmpgt_epi8(v, ctrl))));
+			if (mask_plain != 0xffff) return pos + std::countr_one(mask_plain);
+		}
+	#endif // SIGMA_LIB_TEXT_SCAN_SSE2
+		for (; pos < str.size(); pos++) {
+			uint8_t const c = static_cast<uint8_t>(str[pos]);
+			if (c >= 0x80 || classes[c] != plain) break;
+		}
+		return pos;
+	}
+
+	// writes `2 * len` lowercase hexadecimal digits of the binary data to `dst`.
+	inline void encode_hex(uint8_t const* data, size_t len, char* dst)
+	{
+		size_t pos = 0;
+	#ifdef SIGMA_LIB_TEXT_SCAN_SSE2
+		// 16 bytes into 32 digits per loop.
+		__m128i const mask_lo = ::_mm_set1_epi8(0x0f), nine = ::_mm_set1_epi8(9),
+			zero = ::_mm_set1_epi8('0'), alpha = ::_mm_set1_epi8('a' - '0' - 10);
+		auto const to_digits = [&](__m128i n) {
+			// '0' + n, plus the gap to 'a' for n > 9.
+			return ::_mm_add_epi8(::_mm_add_epi8(n, zero), ::_mm_and_si128(::_mm_cmpgt_epi8(n, nine), alpha));
+		};
+		for (; pos + 16 <= len; pos += 16) {
+			__m128i const v = ::_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos)),
+				hi = ::_mm_and_si128(::_mm_srli_epi16(v, 4), mask_lo),
+				lo = ::_mm_and_si128(v, mask_lo);
+			::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * pos), to_digits(::_mm_unpacklo_epi8(hi, lo)));
+			::_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * pos + 16), to_digits(::_mm_unpackhi_epi8(hi, lo)));
+		}
+	#endif // SIGMA_LIB_TEXT_SCAN_SSE2
+		constexpr char digits[] = "0123456789abcdef";
+		for (; pos < len; pos++) {
+			dst[2 * pos] = digits[data[pos] >> 4];
+			dst[2 * pos + 1] = digits[data[pos] & 0x0f];
+		}
+	}
+
+	// appends the escape sequence of a byte.
+	inline void append_escaped(std::string& s, char c)
+	{
+		s.append(1, '\\');
+		switch (c) {
+		default:
+		{
+			uint8_t const b = static_cast<uint8_t>(c);
+			char const buf[3] = { static_cast<char>('0' + b / 100),
+				static_cast<char>('0' + b / 10 % 10), static_cast<char>('0' + b % 10) };
+			s.append(buf, 3);
+			return;
+		}
+		case '\a': c = 'a'; break;
+		case '\b': c = 'b'; break;
+		case '\f': c = 'f'; break;
+		case '\n': c = 'n'; break;
+		case '\r': c = 'r'; break;
+		case '\t': c = 't'; break;
+		case '\v': c = 'v'; break;
+		case '\\': c = '\\'; break;
+		case '\"': c = '\"'; break;
+		}
+		s.append(1, c);
+	}
+
+	/// escapes the string for a Lua string literal, leaving double-byte characters as they are.
+	/// @return the escaped string, or empty when escaping is not necessary.
+	inline std::string escape_string(std::string_view const& str, char_class_table const& classes)
+	{
+		auto const class_at = [&](size_t i) { return classes[static_cast<uint8_t>(str[i])]; };
+
+		// runs of characters that need no escaping are copied at once, only after the first escape.
+		std::string ret{};
+		size_t copied = 0;
+		bool escaped = false;
+		auto const escape_at = [&](size_t pos, size_t cnt) {
+			if (!escaped) ret.reserve(4 * str.size());
+			escaped = true;
+			ret.append(str.data() + copied, pos - copied);
+			for (size_t i = pos; i < pos + cnt; i++) append_escaped(ret, str[i]);
+			copied = pos + cnt;
+		};
+
+		for (size_t pos = skip_plain(str, 0, classes); pos < str.size(); pos = skip_plain(str, pos, classes)) {
+			auto const cls = class_at(pos);
+			if ((cls & lead) != 0) {
+				if (pos + 1 == str.size())
+					// illegal character here. let it escape.
+					escape_at(pos, 1);
+				else if ((class_at(pos + 1) & escape) != 0)
+					// turn the both to escape sequences.
+					escape_at(pos, 2);
+				// otherwise no need to escape.
+				pos += 2;
+			}
+			else {
+				if ((cls & escape) != 0) escape_at(pos, 1);
+				pos++;
+			}
+		}
+
+		if (!escaped) return {};
+		ret.append(str.data() + copied, str.size() - copied);
+		return ret;
+	}
+}
@@ -84,6 +84,64 @@ void update_current_frame()
 	::PostMessageW(exedit.fp->hwnd, msg_update_main, 0, 0);
 }
 
+// シーンの表示名．
+#ifndef _DEBUG
+constinit
+#endif // !_DEBUG
+static struct {
+	std::wstring_view get(int index)
+	{
+		if (!(0 <= index && index < max_scenes)) return {};
+
+		// rebuild the table only when any of the scene names changed.
+		if (auto const h = hash_names(); !valid || h != hash) {
+			build();
+			hash = h;
+			valid = true;
+		}
+		return labels[index];
+	}
+
+private:
+	std::wstring labels[max_scenes]{};
+	uint32_t hash = 0;
+	bool valid = false;
+
+	// FNV-1a over all the scene names, distinguishing unnamed scenes from empty names.
+	static uint32_t hash_names()
+	{
+		uint32_t h = 0x811c9dc5;
+		constexpr auto feed = [](uint32_t& h, byte b) { h = (h ^ b) * 0x01000193; };
+		for (int i = 0; i < max_scenes; i++) {
+			if (auto const* name = exedit.scene_settings[i].name; name != nullptr) {
+				for (; *name != '\0'; name++) feed(h, static_cast<byte>(*name));
+				feed(h, 0);
+			}
+			else feed(h, 1);
+		}
+		return h;
+	}
+	void build()
+	{
+		using sigma_lib::string::encode_sys;
+
+		for (int i = 0; i < max_scenes; i++) {
+			auto& label = labels[i];
+			if (i == 0) label = L"Root";
+			else {
+				wchar_t buf[16];
+				label.assign(buf, ::swprintf_s(buf, L"Scene %d", i));
+			}
+
+			// if it has a custom name, place it at the head.
+			if (auto const* name = exedit.scene_settings[i].name;
+				name != nullptr && name[0] != '\0')
+				label = encode_sys::to_wide_str(name) + L" (" + label + L")";
+		}
+	}
+} scene_labels;
+std::wstring_view scene_display_name(int index) { return scene_labels.get(index); }
+
 // 競合通知メッセージ．
 bool warn_conflict(wchar_t const* module_name, wchar_t const* ini_piece, char const* this_plugin_name)
 {
@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR I
 #include <cstdint>
 #include <bit>
 #include <concepts>
+#include <string>
 
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
@@ -83,7 +84,7 @@ inline constinit struct ExEdit092 {
 	AviUtl::FilterPlugin* fp;
 	bool init(AviUtl::FilterPlugin* this_fp);
 
-	//int32_t*	ObjectAllocNum;				// 0x1e0fa0
+	int32_t*	ObjectAllocNum;				// 0x1e0fa0
 	ExEdit::Object**	ObjectArray_ptr;	// 0x1e0fa4; Object(*)[].
 	int32_t*	NextObjectIdxArray;			// 0x1592d8
 	int32_t*	SettingDialogObjectIndex;	// 0x177a10
@@ -153,7 +154,7 @@ private:
 	{
 		auto pick_addr = [exedit_base=reinterpret_cast<uintptr_t>(dll_hinst)]
 			<class T>(T& target, ptrdiff_t offset) { target = std::bit_cast<T>(exedit_base + offset); };
-		//pick_addr(ObjectAllocNum,			0x1e0fa0);
+		pick_addr(ObjectAllocNum,			0x1e0fa0);
 		pick_addr(ObjectArray_ptr,			0x1e0fa4);
 		pick_addr(NextObjectIdxArray,		0x1592d8);
 		pick_addr(SettingDialogObjectIndex,	0x177a10);
@@ -213,6 +214,13 @@ void update_setting_dialog(int index);
 // 編集データの変更でメイン画面を更新．
 void update_current_frame();
 
+// シーンの表示名．
+constexpr int max_scenes = 50;
+/// @param index the index of the scene.
+/// @return the name to display for the scene, such as "Root", "Scene 3" or "name (Scene 3)".
+/// empty if `index` is out of range. valid until the next call to this function.
+std::wstring_view scene_display_name(int index);
+
 template<class ExDataT>
 inline ExDataT* find_exdata(ptrdiff_t obj_exdata_offset, ptrdiff_t filter_exdata_offset) {
 	return reinterpret_cast<ExDataT*>((*exedit.exdata_table)
@@ -0,0 +1,48 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+////////////////////////////////
+// 単体テストの最小限の枠組み．
+////////////////////////////////
+namespace test
+{
+	inline int failures = 0;
+
+	// a fixed seed keeps the fuzzing reproducible.
+	inline std::mt19937_64& rng()
+	{
+		static std::mt19937_64 engine{ 0x5eed'1234'abcd'0001ull };
+		return engine;
+	}
+
+	// returns the exit code of the test program.
+	inline int result()
+	{
+		if (failures == 0) std::puts("all passed.");
+		else std::printf("%d failure(s).\n", failures);
+		return failures == 0 ? 0 : 1;
+	}
+}
+
+// records a failure with its location, and continues the test.
+#define CHECK(...) do { \
+	if (!(__VA_ARGS__)) { \
+		test::failures++; \
+		std::printf("%s:%d: CHECK(%s) failed.\n", __FILE__, __LINE__, #__VA_ARGS__); \
+	} \
+} while (false)
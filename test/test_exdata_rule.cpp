@@ -0,0 +1,167 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "exdata_rule.hpp"
+#include "check.hpp"
+
+using sigma_lib::exdata::rule;
+
+// the values of `ExEdit::ExdataUse::Type` are not needed to be the real ones here.
+enum : int32_t { type_number = 0, type_binary = 1, type_string = 2 };
+
+static std::wstring from_utf8(std::string_view str)
+{
+	std::wstring ret;
+	for (size_t i = 0; i < str.size(); ) {
+		uint32_t c = static_cast<uint8_t>(str[i++]);
+		int const tail = c < 0x80 ? 0 : c < 0xe0 ? 1 : c < 0xf0 ? 2 : 3;
+		c &= 0x7f >> tail;
+		for (int k = 0; k < tail && i < str.size(); k++) c = (c << 6) | (str[i++] & 0x3f);
+		ret.push_back(static_cast<wchar_t>(c));
+	}
+	return ret;
+}
+
+// reads a section of an ini file like `GetPrivateProfileStringA()`, which strips the surrounding quotes.
+static std::map<std::string, std::wstring> read_section(char const* path, std::string_view section)
+{
+	std::map<std::string, std::wstring> ret;
+	std::ifstream file{ path };
+	bool in_section = false;
+	for (std::string line; std::getline(file, line); ) {
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		if (line.empty() || line[0] == ';') continue;
+		if (line[0] == '[') { in_section = line == "[" + std::string{ section } + "]"; continue; }
+		if (!in_section) continue;
+
+		auto const eq = line.find('=');
+		if (eq == line.npos) continue;
+		std::string val = line.substr(eq + 1);
+		if (val.size() >= 2 && val.front() == '"' && val.back() == '"') val = val.substr(1, val.size() - 2);
+		ret.emplace(line.substr(0, eq), from_utf8(val));
+	}
+	return ret;
+}
+
+// compiles the rules in the same way as `Filters_Tooltip.cpp`.
+static std::vector<rule> load_rules(char const* path)
+{
+	constexpr size_t max_rules = 64;
+	auto const section = read_section(path, "Filters.Tooltip.Exdata");
+
+	std::vector<rule> rules;
+	for (size_t i = 1; i <= max_rules; i++) {
+		auto key = [&](char const* field) { return std::to_string(i) + "." + field; };
+		auto read_str = [&](char const* field) {
+			auto it = section.find(key(field));
+			return it == section.end() ? std::wstring{} : it->second;
+		};
+		auto read_int = [&](char const* field, int32_t def, int32_t min, int32_t max) {
+			auto it = section.find(key(field));
+			if (it == section.end()) return def;
+			return std::clamp<int32_t>(std::stoi(std::string{ it->second.begin(), it->second.end() }), min, max);
+		};
+
+		auto pattern = read_str("name");
+		if (pattern.empty()) break;
+
+		auto r = rule::parse(pattern, read_str, read_int, [](std::wstring const& type) {
+			if (type == L"number") return static_cast<int32_t>(type_number);
+			if (type == L"binary") return static_cast<int32_t>(type_binary);
+			if (type == L"string") return static_cast<int32_t>(type_string);
+			return rule::any_type;
+		});
+		if (!r) continue;
+		rules.push_back(std::move(*r));
+	}
+	return rules;
+}
+
+// a synthetic exdata entry.
+struct entry {
+	std::wstring name;
+	int32_t type;
+	std::vector<uint8_t> data;
+};
+static std::vector<uint8_t> le_bytes(uint64_t val, size_t size)
+{
+	std::vector<uint8_t> ret(size);
+	for (auto& b : ret) { b = static_cast<uint8_t>(val); val >>= 8; }
+	return ret;
+}
+
+// formats the entry with the first matching rule, or returns "(none)".
+static std::wstring format(std::vector<rule> const& rules, entry const& e)
+{
+	for (auto const& r : rules) {
+		if (!r.matches(static_cast<int32_t>(e.data.size()), e.type, e.name)) continue;
+		std::wstring s;
+		r.append(s, e.name, e.data.data(), static_cast<int32_t>(e.data.size()), [](std::string_view str) {
+			return std::wstring(str.begin(), str.end());
+		});
+		return s;
+	}
+	return L"(none)";
+}
+
+int main(int argc, char** argv)
+{
+	auto const rules = load_rules(argc > 1 ? argv[1] : "exdata_rules.ini");
+
+	// the rule with an invalid pattern is skipped, and the numbering stops at the gap.
+	CHECK(rules.size() == 6);
+
+	// enumeration with the template.
+	CHECK(format(rules, { L"mode", type_number, le_bytes(1, 4) }) == L"モード: 加算");
+	CHECK(format(rules, { L"mode", type_number, le_bytes(0, 4) }) == L"モード: 通常");
+	CHECK(format(rules, { L"mode", type_number, le_bytes(5, 4) }) == L"モード: 5");
+	CHECK(format(rules, { L"mode", type_number, le_bytes(~0ull, 4) }) == L"モード: -1");
+	// the size differs, falling back to the catch-all rule.
+	CHECK(format(rules, { L"mode", type_number, le_bytes(1, 2) }) == L"mode: 1");
+
+	// fixed point, with the digits from the scale.
+	CHECK(format(rules, { L"gain_12", type_number, le_bytes(1500, 4) }) == L"gain_12: 1.500");
+	CHECK(format(rules, { L"gain_3", type_number, le_bytes(static_cast<uint64_t>(-250), 4) }) == L"gain_3: -0.250");
+	CHECK(format(rules, { L"gain_", type_number, le_bytes(1500, 4) }) == L"gain_: 1500");
+
+	// hex dump, limited to 16 bytes.
+	CHECK(format(rules, { L"flags", type_binary, { 0x01, 0xab, 0xff } }) == L"flags: 01abff");
+	CHECK(format(rules, { L"flags", type_binary, std::vector<uint8_t>(20, 0x5a) })
+		== L"flags: 5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a5a...");
+	CHECK(format(rules, { L"flags", type_string, { 0x01 } }) == L"(none)");
+
+	// unsigned integers cover the full range of 64 bits.
+	CHECK(format(rules, { L"count", type_number, le_bytes(0xffff'ffff, 4) }) == L"count: 4294967295");
+	CHECK(format(rules, { L"count", type_number, le_bytes(~0ull, 8) }) == L"count: 18446744073709551615");
+	CHECK(format(rules, { L"count", type_number, le_bytes(0x8000'0000'0000'0000ull, 8) }) == L"count: 9223372036854775808");
+	CHECK(format(rules, { L"count", type_number, le_bytes(200, 1) }) == L"count: 200");
+	// and the signed ones are sign-extended.
+	CHECK(format(rules, { L"other", type_number, le_bytes(~0ull, 8) }) == L"other: -1");
+	CHECK(format(rules, { L"other", type_number, le_bytes(200, 1) }) == L"other: -56");
+
+	// strings stop at the terminator or at the end of the entry.
+	CHECK(format(rules, { L"file", type_string, { 'a', 'b', 'c', 0, 'd', 'e' } }) == L"[abc]");
+	CHECK(format(rules, { L"file", type_string, { 'a', 'b', 'c' } }) == L"[abc]");
+
+	// the pattern must match the whole name.
+	CHECK(format(rules, { L"modes", type_binary, le_bytes(1, 4) }) == L"(none)");
+	CHECK(format(rules, { L"(invalid", type_binary, le_bytes(1, 4) }) == L"(none)");
+
+	return test::result();
+}
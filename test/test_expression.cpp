@@ -0,0 +1,134 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "expression.hpp"
+#include "check.hpp"
+
+using sigma_lib::expression::program;
+
+constexpr std::wstring_view var_names[] = { L"x", L"y" };
+
+static bool compiles(std::wstring_view src)
+{
+	return !program::compile(src, var_names).empty();
+}
+static double eval(std::wstring_view src, double x = 0, double y = 0)
+{
+	auto const prog = program::compile(src, var_names);
+	if (prog.empty()) return std::nan("");
+	std::vector<double> stack(prog.stack_size());
+	double const vars[] = { x, y };
+	return prog.eval(vars, stack.data());
+}
+
+static std::wstring repeat(std::wstring_view head, size_t count, std::wstring_view body, std::wstring_view tail = L"")
+{
+	std::wstring ret;
+	for (size_t i = 0; i < count; i++) ret.append(head);
+	ret.append(body);
+	for (size_t i = 0; i < count; i++) ret.append(tail);
+	return ret;
+}
+
+static void precedence()
+{
+	CHECK(eval(L"1 + 2 * 3") == 7);
+	CHECK(eval(L"(1 + 2) * 3") == 9);
+	CHECK(eval(L"10 - 4 - 3") == 3);
+	CHECK(eval(L"8 / 4 / 2") == 1);
+	CHECK(eval(L"7 % 4 * 2") == 6);
+	CHECK(eval(L"2 * 3 ^ 2") == 18);
+	CHECK(eval(L"1 - 2 * 3 + 4") == -1);
+	CHECK(eval(L"x * 2 + y", 3, 4) == 10);
+	CHECK(eval(L"1.5e1 + .5") == 15.5);
+}
+
+static void power()
+{
+	// right associative.
+	CHECK(eval(L"2 ^ 3 ^ 2") == 512);
+	CHECK(eval(L"(2 ^ 3) ^ 2") == 64);
+
+	// the unary minus binds looser than `^` on its right.
+	CHECK(eval(L"-2 ^ 2") == -4);
+	CHECK(eval(L"(-2) ^ 2") == 4);
+	CHECK(eval(L"2 ^ -1") == 0.5);
+	CHECK(eval(L"-x ^ 2", 3) == -9);
+	CHECK(eval(L"--2") == 2);
+	CHECK(eval(L"+-+2") == -2);
+}
+
+static void functions()
+{
+	CHECK(eval(L"min(3, x)", 2) == 2);
+	CHECK(eval(L"max(3, x)", 2) == 3);
+	CHECK(eval(L"clamp(x, 0, 1)", 1.5) == 1);
+	CHECK(eval(L"lerp(0, 10, 0.25)") == 2.5);
+	CHECK(eval(L"abs(-x) + floor(2.7) + ceil(2.1) + round(2.5)", 1) == 9);
+	CHECK(std::abs(eval(L"atan2(1, 1) * 4") - std::numbers::pi) < 1e-12);
+	CHECK(eval(L"pow(2, 10)") == 1024);
+	CHECK(eval(L"sqrt(x ^ 2 + y ^ 2)", 3, 4) == 5);
+}
+
+static void malformed()
+{
+	for (auto src : {
+		L"", L" ", L"1 +", L"* 2", L"(1", L"1)", L"()", L"1 2", L"2 ^", L"x y",
+		L"1..2", L"1e", L"z", L"foo(1)", L"abs", L"abs 1", L"sqrt()",
+		L"min(1)", L"min(1, 2, 3)", L"min(1 2)", L"1 # 2",
+	}) CHECK(!compiles(src));
+}
+
+static void nesting()
+{
+	constexpr size_t limit = 128;
+
+	// each of parentheses, signs, powers and function calls counts as a level.
+	CHECK(eval(repeat(L"(", limit, L"1", L")")) == 1);
+	CHECK(!compiles(repeat(L"(", limit + 1, L"1", L")")));
+	CHECK(eval(repeat(L"-", limit, L"1")) == 1);
+	CHECK(!compiles(repeat(L"-", limit + 1, L"1")));
+	CHECK(eval(repeat(L"abs(", limit, L"1", L")")) == 1);
+	CHECK(!compiles(repeat(L"abs(", limit + 1, L"1", L")")));
+	CHECK(eval(repeat(L"1^", limit, L"1")) == 1);
+	CHECK(!compiles(repeat(L"1^", limit + 1, L"1")));
+	CHECK(eval(repeat(L"-(", limit / 2, L"1", L")")) == 1);
+	CHECK(!compiles(repeat(L"-(", limit / 2, L"-1", L")")));
+
+	// siblings do not add up.
+	CHECK(eval(repeat(L"(", limit, L"1", L")") + L" + " + repeat(L"(", limit, L"1", L")")) == 2);
+
+	// deep inputs fail without exhausting the stack.
+	CHECK(!compiles(repeat(L"(", 1'000'000, L"1", L")")));
+	CHECK(!compiles(repeat(L"-", 1'000'000, L"1")));
+	CHECK(!compiles(repeat(L"(", 1'000'000, L"")));
+
+	// long but flat expressions are fine, with a shallow stack.
+	auto const flat = program::compile(repeat(L"1+", 100'000, L"1"), var_names);
+	CHECK(!flat.empty() && flat.stack_size() == 2);
+}
+
+int main()
+{
+	precedence();
+	power();
+	functions();
+	malformed();
+	nesting();
+	return test::result();
+}
@@ -0,0 +1,151 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "index_batch.hpp"
+#include "check.hpp"
+
+using namespace sigma_lib::batch;
+
+// random objects, each of which leads its chain or follows a leader at a smaller index.
+static std::vector<int> random_leaders(size_t count)
+{
+	auto& rng = test::rng();
+	std::vector<int> ret(count);
+	for (size_t i = 0; i < count; i++)
+		ret[i] = i == 0 || rng() % 3 == 0 ? -1 : static_cast<int>(rng() % i);
+	for (size_t i = 0; i < count; i++) {
+		// the leader of a follower is a leader itself.
+		if (ret[i] >= 0 && ret[ret[i]] >= 0) ret[i] = ret[ret[i]];
+	}
+	return ret;
+}
+static std::vector<int> random_selection(size_t count, size_t num_objects)
+{
+	auto& rng = test::rng();
+	std::vector<int> ret(count);
+	for (auto& i : ret) i = static_cast<int>(rng() % num_objects); // duplicates included.
+	return ret;
+}
+
+// the former collection through `std::map::try_emplace()`.
+static std::vector<size_t> reference_keys(size_t first, std::span<int const> indices, auto&& key_of)
+{
+	struct payload { int dummy[8]; };
+	std::map<size_t, payload> map;
+	map.try_emplace(key_of(first));
+	for (int i : indices) map.try_emplace(key_of(static_cast<size_t>(i)));
+
+	std::vector<size_t> ret;
+	for (auto const& [k, _] : map) ret.push_back(k);
+	return ret;
+}
+
+static void distinct_keys_fuzz(size_t rounds)
+{
+	auto& rng = test::rng();
+	for (size_t n = 0; n < rounds; n++) {
+		size_t const num_objects = 1 + rng() % 2000;
+		auto const leaders = random_leaders(num_objects);
+		auto const selection = random_selection(rng() % 300, num_objects);
+		size_t const first = rng() % num_objects;
+		auto const key_of = [&](size_t i) { return leaders[i] < 0 ? i : static_cast<size_t>(leaders[i]); };
+
+		// the capacity may be short of the keys, then the bitmap grows.
+		size_t const capacity = rng() % 2 == 0 ? num_objects : rng() % (num_objects + 1);
+		CHECK(distinct_keys(first, selection, capacity, key_of) == reference_keys(first, selection, key_of));
+	}
+}
+
+// reports the speed against the former collection, selecting 10k objects.
+static void distinct_keys_benchmark()
+{
+	using clock = std::chrono::steady_clock;
+	constexpr size_t num_objects = 20'000, num_selected = 10'000, repeat = 20;
+	auto const leaders = random_leaders(num_objects);
+	auto const selection = random_selection(num_selected, num_objects);
+	auto const key_of = [&](size_t i) { return leaders[i] < 0 ? i : static_cast<size_t>(leaders[i]); };
+
+	size_t sum = 0;
+	auto t0 = clock::now();
+	for (size_t r = 0; r < repeat; r++) sum += reference_keys(0, selection, key_of).size();
+	auto t1 = clock::now();
+	for (size_t r = 0; r < repeat; r++) sum -= distinct_keys(0, selection, num_objects, key_of).size();
+	auto t2 = clock::now();
+
+	CHECK(sum == 0);
+	std::printf("leaders of %zu selected objects: map %.3f ms, bitmap %.3f ms.\n", num_selected,
+		std::chrono::duration<double, std::milli>(t1 - t0).count() / repeat,
+		std::chrono::duration<double, std::milli>(t2 - t1).count() / repeat);
+}
+
+// a pure per-chain computation, standing for the dry run of a command.
+struct chain_result {
+	std::vector<int> values;
+	double sum = 0;
+};
+static void compute_chain(chain_result& res, size_t k, std::span<std::vector<int> const> chains)
+{
+	auto const& src = chains[k];
+	res.values.resize(src.size());
+	for (size_t i = 0; i < src.size(); i++) {
+		// rounding and a floating sum in a fixed order per chain.
+		double const v = std::sin(src[i] * 0.001 + static_cast<double>(k)) * 1000;
+		res.values[i] = static_cast<int>(std::lround(v));
+		res.sum += v;
+	}
+}
+
+// the results must not depend on running in parallel nor on the scheduling of the threads.
+static void for_each_indexed_determinism()
+{
+	auto& rng = test::rng();
+	std::vector<std::vector<int>> chains(5'000);
+	for (auto& c : chains) {
+		c.resize(1 + rng() % 64);
+		for (auto& v : c) v = static_cast<int>(rng() % 200'000) - 100'000;
+	}
+	auto const run = [&](size_t threshold) {
+		std::vector<chain_result> results(chains.size());
+		for_each_indexed(results, [&](chain_result& res, size_t k) { compute_chain(res, k, chains); }, threshold);
+		return results;
+	};
+	auto const equal = [](std::vector<chain_result> const& a, std::vector<chain_result> const& b) {
+		return std::ranges::equal(a, b, [](chain_result const& x, chain_result const& y) {
+			return x.values == y.values && x.sum == y.sum; // bitwise equal, not approximately.
+		});
+	};
+
+	auto const serial = run(~0uz);
+	for (int r = 0; r < 10; r++) CHECK(equal(run(0), serial));
+	// and below the threshold, which runs serially.
+	CHECK(equal(run(chains.size() + 1), serial));
+
+	// the positions passed to the function are each exactly once.
+	std::vector<size_t> seen(chains.size(), 0);
+	for_each_indexed(seen, [](size_t& s, size_t k) { s += k + 1; }, 0);
+	for (size_t k = 0; k < seen.size(); k++) CHECK(seen[k] == k + 1);
+}
+
+int main()
+{
+	distinct_keys_fuzz(2'000);
+	distinct_keys_benchmark();
+	for_each_indexed_determinism();
+	return test::result();
+}
@@ -0,0 +1,119 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "line_breaks.hpp"
+#include "check.hpp"
+
+using namespace sigma_lib::string;
+
+// the former conversion in the Lua export, inserting CRs one by one.
+template<class CharT>
+static std::basic_string<CharT> reference_crlf(std::basic_string<CharT> str)
+{
+	for (size_t pos = 0; pos = str.find(CharT('\n'), pos), pos != str.npos; pos++) {
+		if (pos > 0 && str[pos - 1] == CharT('\r')) continue;
+		str.insert(pos, 1, CharT('\r')); pos++;
+	}
+	return str;
+}
+
+template<class CharT>
+static std::basic_string<CharT> random_text(size_t len)
+{
+	constexpr CharT alphabet[] = { CharT('\n'), CharT('\r'), CharT('a'), CharT('\0'), CharT(0xff) };
+	auto& rng = test::rng();
+	std::basic_string<CharT> ret(len, CharT{});
+	for (auto& c : ret) c = alphabet[rng() % std::size(alphabet)];
+	return ret;
+}
+
+// compares the single-pass conversions with the former one on random texts.
+template<class CharT>
+static void fuzz(size_t rounds)
+{
+	auto& rng = test::rng();
+	for (size_t n = 0; n < rounds; n++) {
+		auto const src = random_text<CharT>(rng() % 40);
+		auto const ref = reference_crlf(src);
+		std::basic_string_view<CharT> const view{ src };
+
+		CHECK(crlf_length(view) == ref.size());
+
+		std::basic_string<CharT> dst(ref.size() + 1, CharT('#'));
+		CharT* const end = copy_crlf(view, dst.data());
+		CHECK(end == dst.data() + ref.size());
+		CHECK(dst.substr(0, ref.size()) == ref);
+		CHECK(dst.back() == CharT('#')); // nothing written beyond.
+
+		// in place, with the exact room and with some spare.
+		std::basic_string<CharT> buf = src;
+		buf.resize(ref.size() + rng() % 3, CharT('#'));
+		size_t const len = expand_crlf(buf.data(), src.size(), buf.size());
+		CHECK(len == ref.size());
+		CHECK(buf.substr(0, len) == ref);
+
+		// insufficient room leaves the text as is.
+		if (ref.size() > src.size()) {
+			buf = src;
+			CHECK(expand_crlf(buf.data(), src.size(), ref.size() - 1) == src.size());
+			CHECK(buf == src);
+		}
+	}
+}
+
+static void edges()
+{
+	using namespace std::string_view_literals;
+	CHECK(crlf_length(""sv) == 0);
+	CHECK(crlf_length("\n"sv) == 2);
+	CHECK(crlf_length("\r\n"sv) == 2);
+	CHECK(crlf_length("\r"sv) == 1);
+	CHECK(crlf_length("\n\n\r\r\n"sv) == 7);
+
+	char buf[8] = "a\nb";
+	CHECK(expand_crlf(buf, 3, 4) == 4);
+	CHECK(std::string_view(buf, 4) == "a\r\nb");
+}
+
+// reports the speed against the former conversion on a large text.
+static void benchmark()
+{
+	using clock = std::chrono::steady_clock;
+	auto const src = random_text<char>(256 << 10);
+
+	auto t0 = clock::now();
+	auto const ref = reference_crlf(src);
+	auto t1 = clock::now();
+	std::string dst(crlf_length(std::string_view{ src }), '\0');
+	copy_crlf(std::string_view{ src }, dst.data());
+	auto t2 = clock::now();
+
+	CHECK(dst == ref);
+	std::printf("crlf of %zu bytes: former %.2f ms, single pass %.2f ms.\n", src.size(),
+		std::chrono::duration<double, std::milli>(t1 - t0).count(),
+		std::chrono::duration<double, std::milli>(t2 - t1).count());
+}
+
+int main()
+{
+	edges();
+	fuzz<char>(100'000);
+	fuzz<wchar_t>(100'000);
+	benchmark();
+	return test::result();
+}
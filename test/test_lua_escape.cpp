@@ -0,0 +1,176 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "lua_escape.hpp"
+#include "check.hpp"
+
+namespace lua = sigma_lib::lua;
+
+// lead bytes of Shift_JIS, standing for `IsDBCSLeadByte()` of the system code page.
+static bool is_lead_sjis(uint8_t c) { return (0x81 <= c && c <= 0x9f) || (0xe0 <= c && c <= 0xfc); }
+static lua::char_class_table const classes = lua::make_char_classes(is_lead_sjis);
+
+// the former implementation, walking the string byte by byte.
+static std::string reference_escape(std::string_view const& str)
+{
+	constexpr auto should_escape = [](char c) {
+		return ('\0' <= c && c <= '\x1f') || c == '\\' || c == '"';
+	};
+	constexpr auto append_escaped = [](std::string& s, char c) {
+		s.append(1, '\\');
+		switch (c) {
+		default:
+		{
+			char buf[8];
+			s.append(buf, std::snprintf(buf, std::size(buf), "%03d", static_cast<uint8_t>(c)));
+			return;
+		}
+		case '\a': c = 'a'; break;
+		case '\b': c = 'b'; break;
+		case '\f': c = 'f'; break;
+		case '\n': c = 'n'; break;
+		case '\r': c = 'r'; break;
+		case '\t': c = 't'; break;
+		case '\v': c = 'v'; break;
+		case '\\': c = '\\'; break;
+		case '\"': c = '\"'; break;
+		}
+		s.append(1, c);
+	};
+	auto const is_lead = [](char c) { return is_lead_sjis(static_cast<uint8_t>(c)); };
+
+	if (std::none_of(str.begin(), str.end(), should_escape) &&
+		(str.empty() || !is_lead(str.back()))) return {};
+
+	std::string ret{}; ret.reserve(4 * str.size());
+	for (auto p = str.begin(), e = str.end(); p != e; p++) {
+		if (is_lead(*p)) {
+			if (auto q = p + 1; q == e)
+				append_escaped(ret, *p);
+			else {
+				if (should_escape(*q)) {
+					append_escaped(ret, *p);
+					append_escaped(ret, *q);
+				}
+				else ret.append(&*p, 2);
+				p = q;
+			}
+		}
+		else if (should_escape(*p)) append_escaped(ret, *p);
+		else ret.append(1, *p);
+	}
+	return ret;
+}
+
+static void escape_fuzz(size_t rounds)
+{
+	// mostly plain runs longer than a vector, with occasional specials and double-byte characters.
+	constexpr char specials[] = { '\0', '\n', '\r', '\t', '\a', '\x1f', '\\', '"', '\x7f', ' ',
+		'\x81', '\x9f', '\xe0', '\xfc', '\x80', '\xa0', '\xfd', '\xff', '\x5c', '\x40' };
+	auto& rng = test::rng();
+	std::string buf;
+	for (size_t n = 0; n < rounds; n++) {
+		size_t const len = rng() % 100, offset = rng() % 16;
+		uint64_t const rate = 1 + rng() % 16;
+		buf.assign(offset + len, 'x');
+		for (size_t i = offset; i < buf.size(); i++) {
+			auto const r = rng();
+			buf[i] = r % 32 < rate ? specials[(r >> 8) % std::size(specials)] : static_cast<char>(0x20 + (r >> 8) % 0x5f);
+		}
+		std::string_view const str{ buf.data() + offset, len };
+
+		// compare the texts to be written; the former one could return a copy of the input
+		// in place of the empty result, when the string ends with a double-byte character.
+		auto const effective = [&](std::string const& s) { return s.empty() ? std::string{ str } : s; };
+		auto const ref = effective(reference_escape(str)), ret = effective(lua::escape_string(str, classes));
+		CHECK(ret == ref);
+		if (ret != ref) {
+			for (auto c : str) std::printf("%02x ", static_cast<uint8_t>(c));
+			std::puts("");
+			break;
+		}
+	}
+}
+
+static void escape_cases()
+{
+	CHECK(lua::escape_string("", classes).empty());
+	CHECK(lua::escape_string("plain text of more than sixteen bytes", classes).empty());
+	CHECK(lua::escape_string("a\"b\\c\n", classes) == "a\\\"b\\\\c\\n");
+	CHECK(lua::escape_string(std::string_view{ "\0\x01\x7f", 3 }, classes) == "\\000\\001\x7f");
+	// a double-byte character is escaped as a whole if its trail byte needs escaping.
+	CHECK(lua::escape_string("\x95\x5c", classes) == "\\149\\\\");
+	CHECK(lua::escape_string("\x95\n", classes) == "\\149\\n");
+	CHECK(lua::escape_string("\x95\x40\xe0\xe0", classes).empty());
+	// a lead byte at the end is illegal.
+	CHECK(lua::escape_string("abc\x95", classes) == "abc\\149");
+}
+
+// the former encoding, a nibble at a time.
+static void reference_hex(uint8_t const* data, size_t len, char* dst)
+{
+	constexpr auto hex = [](uint8_t b) -> char {
+		if (b < 10) return '0' + b;
+		else return ('a' - 10) + b;
+	};
+	for (auto p = data, e = data + len; p < e; p++) {
+		*(dst++) = hex((*p) >> 4);
+		*(dst++) = hex((*p) & 0x0f);
+	}
+}
+
+// every length up to 4096 at every alignment in a vector, compared also with "%02x".
+static void hex_all_lengths()
+{
+	constexpr size_t max_len = 4096, max_offset = 16;
+	auto& rng = test::rng();
+	std::vector<uint8_t> src(max_len + max_offset);
+	for (auto& b : src) b = static_cast<uint8_t>(rng());
+	for (size_t i = 0; i < 256; i++) src[i] = static_cast<uint8_t>(i); // every byte value.
+
+	std::string dst, ref;
+	for (size_t offset = 0; offset < max_offset; offset++) {
+		for (size_t len = 0; len <= max_len; len++) {
+			uint8_t const* const data = src.data() + offset;
+			// guard bytes on both sides catch writes out of the range.
+			dst.assign(2 * len + 2, '#'); ref.assign(2 * len, '\0');
+			lua::encode_hex(data, len, dst.data() + 1);
+			reference_hex(data, len, ref.data());
+
+			bool ok = dst.front() == '#' && dst.back() == '#' && dst.substr(1, 2 * len) == ref;
+			CHECK(ok);
+			if (!ok) return;
+		}
+	}
+
+	dst.assign(2 * 256, '\0');
+	lua::encode_hex(src.data(), 256, dst.data());
+	char buf[4];
+	for (size_t i = 0; i < 256; i++) {
+		std::snprintf(buf, std::size(buf), "%02x", static_cast<unsigned>(i));
+		CHECK(std::string_view(dst.data() + 2 * i, 2) == buf);
+	}
+}
+
+int main()
+{
+	escape_cases();
+	escape_fuzz(300'000);
+	hex_all_lengths();
+	return test::result();
+}
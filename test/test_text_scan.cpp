@@ -0,0 +1,122 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "text_scan.hpp"
+#include "check.hpp"
+
+using sigma_lib::string::scan_text;
+using sigma_lib::string::bounded_length;
+
+// the former implementation in the tooltip, built on the searches of `std::basic_string_view`.
+template<class CharT>
+static std::basic_string_view<CharT> reference_trim(CharT const* data, size_t size)
+{
+	constexpr CharT line_breaks[] = { CharT('\r'), CharT('\n'), CharT('\0') };
+	std::basic_string_view<CharT> text{ data, size };
+	text = text.substr(0, text.find_first_of(CharT('\0')));
+	if (auto pos = text.find_first_not_of(line_breaks); pos != text.npos)
+		text = text.substr(pos);
+	if (auto pos = text.find_last_not_of(line_breaks); pos != text.npos)
+		text = text.substr(0, pos + 1);
+	return text;
+}
+
+template<class CharT>
+static bool only_line_breaks(std::basic_string_view<CharT> text)
+{
+	return text.find_first_not_of(std::basic_string_view<CharT>{ std::array{ CharT('\r'), CharT('\n') }.data(), 2 }) == text.npos;
+}
+
+// compares `scan_text()` with the former implementation on random buffers.
+template<class CharT>
+static void fuzz(size_t rounds)
+{
+	// line breaks and terminators appear often enough to hit every boundary of the vector lanes.
+	constexpr CharT alphabet[] = {
+		CharT('\0'), CharT('\r'), CharT('\n'), CharT('a'), CharT('b'), CharT(0x80), CharT(-1),
+	};
+	auto& rng = test::rng();
+	std::vector<CharT> buf;
+	for (size_t n = 0; n < rounds; n++) {
+		size_t const size = rng() % 80, offset = rng() % 4, max_heading = rng() % 100;
+
+		// sparse terminators leave some buffers unterminated.
+		buf.assign(size + offset, CharT('x'));
+		uint64_t const density = 1 + rng() % 3;
+		for (size_t i = offset; i < buf.size(); i++) {
+			auto const r = rng();
+			buf[i] = alphabet[r % 8 < density ? r % std::size(alphabet) : 3 + r % 4];
+			if (buf[i] == CharT('\0') && r % 5 != 0) buf[i] = CharT('\n');
+		}
+		CharT const* const data = buf.data() + offset;
+
+		auto const scan = scan_text(data, size, max_heading);
+		auto const ref = reference_trim(data, size);
+		std::basic_string_view<CharT> const whole{ data, size };
+
+		CHECK(scan.length == std::min(whole.find(CharT('\0')), size));
+		CHECK(bounded_length(data, size) == scan.length);
+
+		// text of line breaks only is now regarded as empty, which was shown as is before.
+		if (only_line_breaks(ref)) CHECK(scan.empty());
+		else {
+			CHECK(!scan.empty());
+			CHECK(scan.trimmed(data) == ref);
+			CHECK(scan.heading(data) == ref.substr(0, max_heading));
+			CHECK(scan.truncated() == (ref.size() > max_heading));
+		}
+	}
+}
+
+// known cases around the edges.
+static void edges()
+{
+	{
+		auto const scan = scan_text("", 0);
+		CHECK(scan.length == 0 && scan.empty() && !scan.truncated());
+	}
+	{
+		// not terminated within the buffer, longer than a vector lane.
+		char const text[] = "\r\n0123456789abcdefghij\r\n";
+		auto const scan = scan_text(text, std::size(text) - 1, 4);
+		CHECK(scan.length == std::size(text) - 1);
+		CHECK(scan.trimmed(text) == "0123456789abcdefghij");
+		CHECK(scan.heading(text) == "0123");
+		CHECK(scan.truncated());
+	}
+	{
+		char16_t const text[] = u"\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\0abc";
+		auto const scan = scan_text(text, std::size(text) - 1);
+		CHECK(scan.length == 16);
+		CHECK(scan.empty());
+	}
+	{
+		// the terminator at the last position of a lane.
+		char const text[] = "abcdefghijklmno\0pq";
+		CHECK(bounded_length(text, std::size(text) - 1) == 15);
+	}
+}
+
+int main()
+{
+	edges();
+	fuzz<char>(200'000);
+	fuzz<char16_t>(200'000);
+	fuzz<wchar_t>(100'000);
+	return test::result();
+}
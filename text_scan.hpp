@@ -0,0 +1,144 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 sigma-axis
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <string>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SIGMA_LIB_TEXT_SCAN_SSE2
+#endif
+
+
+////////////////////////////////
+// 固定長バッファ内テキストの走査．
+////////////////////////////////
+namespace sigma_lib::string
+{
+	// result of `scan_text()`. all positions are counted in characters.
+	struct text_scan_result {
+		size_t length;	// position of the null terminator, or the buffer size if not terminated.
+		size_t first;	// position of the first character other than line breaks. `== last` if none.
+		size_t last;	// position next to the last character other than line breaks.
+		size_t cut;		// `first` advanced by the heading limit, but not exceeding `last`.
+
+		constexpr bool empty() const { return first >= last; }
+		constexpr bool truncated() const { return cut < last; }
+		// the line-break-trimmed text, cut at the heading limit.
+		template<class CharT>
+		constexpr std::basic_string_view<CharT> heading(CharT const* data) const { return { data + first, cut - first }; }
+		// the line-break-trimmed text.
+		template<class CharT>
+		constexpr std::basic_string_view<CharT> trimmed(CharT const* data) const { return { data + first, last - first }; }
+	};
+
+	namespace text_scan_detail
+	{
+		template<class CharT>
+		constexpr bool is_line_break(CharT c) { return c == CharT('\r') || c == CharT('\n'); }
+
+		// scalar path, also handling the tails of the vectorized path.
+		template<class CharT>
+		constexpr void scan_scalar(CharT const* data, size_t pos, size_t size, text_scan_result& ret)
+		{
+			for (; pos < size; pos++) {
+				auto const c = data[pos];
+				if (c == CharT('\0')) break;
+				if (is_line_break(c)) continue;
+				if (ret.first > pos) ret.first = pos;
+				ret.last = pos + 1;
+			}
+			ret.length = pos;
+		}
+
+	#ifdef SIGMA_LIB_TEXT_SCAN_SSE2
+		// vectorized path, 16 bytes per loop.
+		// returns `true` if the null terminator was found.
+		template<class CharT>
+		inline bool scan_sse2(CharT const* data, size_t& pos, size_t size, text_scan_result& ret)
+		{
+			constexpr size_t lanes = sizeof(__m128i) / sizeof(CharT);
+			constexpr auto splat = [](CharT c) {
+				if constexpr (sizeof(CharT) == 1) return ::_mm_set1_epi8(static_cast<char>(c));
+				else return ::_mm_set1_epi16(static_cast<short>(c));
+			};
+			constexpr auto cmpeq = [](__m128i a, __m128i b) {
+				if constexpr (sizeof(CharT) == 1) return ::_mm_cmpeq_epi8(a, b);
+				else return ::_mm_cmpeq_epi16(a, b);
+			};
+			__m128i const nul = ::_mm_setzero_si128(), cr = splat(CharT('\r')), lf = splat(CharT('\n'));
+
+			for (; pos + lanes <= size; pos += lanes) {
+				__m128i const v = ::_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + pos));
+
+				// bits are per byte; a wide character occupies two bits.
+				uint32_t const mask_nul = static_cast<uint32_t>(::_mm_movemask_epi8(cmpeq(v, nul))),
+					mask_lb = static_cast<uint32_t>(::_mm_movemask_epi8(
+						::_mm_or_si128(cmpeq(v, cr), cmpeq(v, lf))));
+
+				// characters at or after the terminator are out of the text.
+				uint32_t mask_valid = 0xffff;
+				if (mask_nul != 0) mask_valid = (1u << std::countr_zero(mask_nul)) - 1;
+
+				if (uint32_t const mask_text = ~(mask_nul | mask_lb) & mask_valid; mask_text != 0) {
+					if (ret.first > pos)
+						ret.first = pos + std::countr_zero(mask_text) / sizeof(CharT);
+					ret.last = pos + (31 - std::countl_zero(mask_text)) / sizeof(CharT) + 1;
+				}
+
+				if (mask_nul != 0) {
+					pos += std::countr_zero(mask_nul) / sizeof(CharT);
+					ret.length = pos;
+					return true;
+				}
+			}
+			return false;
+		}
+	#endif // SIGMA_LIB_TEXT_SCAN_SSE2
+	}
+
+	/// scans a fixed-size text buffer in a single pass, finding the null terminator,
+	/// the range without heading/trailing line breaks, and the cut position for a heading.
+	/// @param data the head of the buffer.
+	/// @param size the number of characters in the buffer. the scan never reads beyond this.
+	/// @param max_heading the maximum number of characters for the heading.
+	/// @return the positions found. see `text_scan_result` for details.
+	template<class CharT> requires(std::same_as<CharT, char> || std::same_as<CharT, wchar_t> || std::same_as<CharT, char16_t>)
+	inline text_scan_result scan_text(CharT const* data, size_t size, size_t max_heading = ~0uz)
+	{
+		text_scan_result ret{ .length = 0, .first = ~0uz, .last = 0, .cut = 0 };
+
+		size_t pos = 0; bool terminated = false;
+	#ifdef SIGMA_LIB_TEXT_SCAN_SSE2
+		if constexpr (sizeof(CharT) <= 2)
+			terminated = text_scan_detail::scan_sse2(data, pos, size, ret);
+	#endif // SIGMA_LIB_TEXT_SCAN_SSE2
+		if (!terminated) text_scan_detail::scan_scalar(data, pos, size, ret);
+
+		// no characters other than line breaks.
+		if (ret.first > ret.last) ret.first = ret.last = 0;
+
+		ret.cut = ret.first + std::min(ret.last - ret.first, max_heading);
+		return ret;
+	}
+
+	/// finds the length of a string in a fixed-size buffer, which may lack the null terminator.
+	template<class CharT> requires(std::same_as<CharT, char> || std::same_as<CharT, wchar_t> || std::same_as<CharT, char16_t>)
+	inline size_t bounded_length(CharT const* data, size_t size) {
+		return scan_text(data, size).length;
+	}
+}